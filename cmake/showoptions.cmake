@@ -33,7 +33,7 @@ else()
 endif()
 
 if( TOOLS )
-  message("* Build map/vmap tools   : Yes")
+  message("* Build map/vmap tools   : Yes (and benchmarks)")
 else()
   message("* Build map/vmap tools   : No  (default)")
 endif()
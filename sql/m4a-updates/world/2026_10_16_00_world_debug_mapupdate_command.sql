@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug mapupdate';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug mapupdate', 3, 'Syntax: .debug mapupdate [#count]\n\nShow per thread busy time and steals of the last map update tick, and the #count (default 10) slowest maps with their phase timings and heaviest grids.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug packetpool';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug packetpool', 3, 'Syntax: .debug packetpool\n\nShow allocations, pool hit rate, releases and dropped buffers of the pooled packet buffers per size class, summed over all threads.');
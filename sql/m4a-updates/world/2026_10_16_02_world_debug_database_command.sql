@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug database';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug database', 3, 'Syntax: .debug database\n\nShow queue depth, executed and batched statements and the wait and execution time histograms of the asynchronous connections of the world, character and login databases.');
@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` IN ('debug replay', 'debug replay start', 'debug replay stop');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug replay', 3, 'Syntax: .debug replay $subcommand\n\nType .debug replay to see the list of possible subcommands or .help debug replay $subcommand to see info on subcommands.'),
+('debug replay start', 3, 'Syntax: .debug replay start $file [$speed]\n\nReplay the client packets of a session capture (PacketLogFormat = 1) through sessions without socket, at $speed times the captured pace (default 1). The accounts and characters of the capture must exist in the local databases. The world update times seen during the replay are written to the server log.'),
+('debug replay stop', 3, 'Syntax: .debug replay stop\n\nStop the running packet replay and log out its sessions.');
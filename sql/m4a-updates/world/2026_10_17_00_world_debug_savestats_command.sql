@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug savestats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug savestats', 3, 'Syntax: .debug savestats [$playername]\n\nShow how many statements the character saves of the selected or named online player queued since login, how many row writes were saved by skipping stored rows and merging rows into multi-row statements, and the bytes of the skipped rows.');
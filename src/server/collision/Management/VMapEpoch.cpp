@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "VMapEpoch.h"
+#include <atomic>
+#include <ace/TSS_T.h>
+#include <ace/OS_NS_Thread.h>
+
+namespace VMAP
+{
+    namespace
+    {
+        // one cache line per reader, so map threads never write to a shared line
+        struct ReaderSlot
+        {
+            ReaderSlot() : epoch(0), used(false) {}
+
+            std::atomic<uint64> epoch;              // 0 while the owning thread is outside a read section
+            std::atomic<bool> used;
+            char pad[64 - sizeof(std::atomic<uint64>) - sizeof(std::atomic<bool>)];
+        };
+
+        std::atomic<uint64> globalEpoch(1);
+        ReaderSlot readerSlots[ReadEpoch::MAX_READERS];
+
+        class ThreadReader
+        {
+            public:
+                ThreadReader() : _slot(NULL), _depth(0) {}
+                ~ThreadReader()
+                {
+                    if (_slot)
+                        _slot->used.store(false);
+                }
+
+                void Enter()
+                {
+                    if (_depth++)
+                        return;
+
+                    if (!_slot)
+                        _slot = ClaimSlot();
+
+                    _slot->epoch.store(globalEpoch.load());
+                }
+
+                void Leave()
+                {
+                    if (--_depth)
+                        return;
+
+                    _slot->epoch.store(0);
+                }
+
+            private:
+                static ReaderSlot* ClaimSlot()
+                {
+                    for (;;)
+                    {
+                        for (uint32 i = 0; i < ReadEpoch::MAX_READERS; ++i)
+                        {
+                            bool expected = false;
+                            if (!readerSlots[i].used.load() && readerSlots[i].used.compare_exchange_strong(expected, true))
+                                return &readerSlots[i];
+                        }
+                        // all slots taken by live threads, wait for one to exit
+                        ACE_OS::thr_yield();
+                    }
+                }
+
+                ReaderSlot* _slot;
+                uint32 _depth;
+        };
+
+        typedef ACE_TSS<ThreadReader> ThreadReaderTSS;
+        ThreadReaderTSS threadReader;
+    }
+
+    ReadEpoch::Guard::Guard()
+    {
+        threadReader->Enter();
+    }
+
+    ReadEpoch::Guard::~Guard()
+    {
+        threadReader->Leave();
+    }
+
+    void ReadEpoch::Synchronize()
+    {
+        uint64 target = ++globalEpoch;
+        for (uint32 i = 0; i < MAX_READERS; ++i)
+        {
+            for (;;)
+            {
+                uint64 epoch = readerSlots[i].epoch.load();
+                if (!epoch || epoch >= target)
+                    break;
+                ACE_OS::thr_yield();
+            }
+        }
+    }
+}
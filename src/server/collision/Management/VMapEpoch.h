@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _VMAPEPOCH_H
+#define _VMAPEPOCH_H
+
+#include "Define.h"
+
+/**
+Epoch based reclamation for the collision trees.
+Queries never take a lock: they only announce the epoch they started in.
+Map and tile unloads unlink data first, then call Synchronize(), which returns
+once every thread that could still hold a reference to the unlinked data has
+left its read section. Only then is the data freed.
+*/
+
+namespace VMAP
+{
+    class ReadEpoch
+    {
+        public:
+            // maximum number of threads that may run collision queries at the same time
+            static const uint32 MAX_READERS = 256;
+
+            class Guard
+            {
+                public:
+                    Guard();
+                    ~Guard();
+                private:
+                    Guard(const Guard&);
+                    Guard& operator=(const Guard&);
+            };
+
+            // blocks until all read sections started before this call have ended
+            static void Synchronize();
+    };
+}
+
+#endif // _VMAPEPOCH_H
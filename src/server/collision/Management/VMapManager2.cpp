@@ -22,6 +22,7 @@
 #include <string>
 #include <sstream>
 #include "VMapManager2.h"
+#include "VMapEpoch.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
 #include "WorldModel.h"
@@ -37,16 +38,19 @@ using G3D::Vector3;
 
 namespace VMAP
 {
-    VMapManager2::VMapManager2()
+    VMapManager2::VMapManager2() : iInstanceMapTrees(new InstanceTreeMap())
     {
     }
 
     VMapManager2::~VMapManager2(void)
     {
-        for (InstanceTreeMap::iterator i = iInstanceMapTrees.begin(); i != iInstanceMapTrees.end(); ++i)
+        _reclaim();
+        InstanceTreeMap* instanceTrees = iInstanceMapTrees.load();
+        for (InstanceTreeMap::iterator i = instanceTrees->begin(); i != instanceTrees->end(); ++i)
         {
             delete i->second;
         }
+        delete instanceTrees;
         for (ModelFileMap::iterator i = iLoadedModelFiles.begin(); i != iLoadedModelFiles.end(); ++i)
         {
             delete i->second.getModel();
@@ -74,11 +78,22 @@ namespace VMAP
         return fname.str();
     }
 
+    StaticMapTree const* VMapManager2::_getMapTree(uint32 mapId) const
+    {
+        InstanceTreeMap const* instanceTrees = iInstanceMapTrees.load();
+        InstanceTreeMap::const_iterator instanceTree = instanceTrees->find(mapId);
+        if (instanceTree == instanceTrees->end())
+            return NULL;
+
+        return instanceTree->second;
+    }
+
     int VMapManager2::loadMap(const char* basePath, unsigned int mapId, int x, int y)
     {
         int result = VMAP_LOAD_RESULT_IGNORED;
         if (isMapLoadingEnabled())
         {
+            TRINITY_GUARD(ACE_Thread_Mutex, MapTreesLock);
             if (_loadMap(mapId, basePath, x, y))
                 result = VMAP_LOAD_RESULT_OK;
             else
@@ -88,47 +103,100 @@ namespace VMAP
         return result;
     }
 
-    // load one tile (internal use only)
+    // load one tile (internal use only), MapTreesLock must be held
     bool VMapManager2::_loadMap(unsigned int mapId, const std::string& basePath, uint32 tileX, uint32 tileY)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-        if (instanceTree == iInstanceMapTrees.end())
+        InstanceTreeMap* instanceTrees = iInstanceMapTrees.load();
+        InstanceTreeMap::iterator instanceTree = instanceTrees->find(mapId);
+        if (instanceTree == instanceTrees->end())
         {
             std::string mapFileName = getMapFileName(mapId);
             StaticMapTree* newTree = new StaticMapTree(mapId, basePath);
             if (!newTree->InitMap(mapFileName, this))
+            {
+                // InitMap may have acquired the global model of a non tiled map before failing
+                newTree->UnloadMap(this);
+                iRetiredTrees.push_back(newTree);
+                _reclaim();
                 return false;
-            instanceTree = iInstanceMapTrees.insert(InstanceTreeMap::value_type(mapId, newTree)).first;
+            }
+
+            // the tree is complete before it becomes visible to queries
+            InstanceTreeMap* newTrees = new InstanceTreeMap(*instanceTrees);
+            (*newTrees)[mapId] = newTree;
+            iInstanceMapTrees.store(newTrees);
+            iRetiredTreeMaps.push_back(instanceTrees);
+            _reclaim();
+            return newTree->LoadMapTile(tileX, tileY, this);
         }
 
         return instanceTree->second->LoadMapTile(tileX, tileY, this);
     }
 
+    // unlink a map tree from the published table, MapTreesLock must be held
+    void VMapManager2::_removeMapTree(uint32 mapId)
+    {
+        InstanceTreeMap* instanceTrees = iInstanceMapTrees.load();
+        InstanceTreeMap::iterator instanceTree = instanceTrees->find(mapId);
+        if (instanceTree == instanceTrees->end())
+            return;
+
+        iRetiredTrees.push_back(instanceTree->second);
+        InstanceTreeMap* newTrees = new InstanceTreeMap(*instanceTrees);
+        newTrees->erase(mapId);
+        iInstanceMapTrees.store(newTrees);
+        iRetiredTreeMaps.push_back(instanceTrees);
+    }
+
+    // free everything unlinked so far, MapTreesLock must be held
+    void VMapManager2::_reclaim()
+    {
+        if (iRetiredInstances.empty() && iDeferredModelReleases.empty() && iRetiredTrees.empty() && iRetiredTreeMaps.empty())
+            return;
+
+        // wait for queries that may still see the unlinked data
+        ReadEpoch::Synchronize();
+
+        for (std::vector<ModelInstance*>::iterator itr = iRetiredInstances.begin(); itr != iRetiredInstances.end(); ++itr)
+            delete *itr;
+        for (std::vector<std::string>::iterator itr = iDeferredModelReleases.begin(); itr != iDeferredModelReleases.end(); ++itr)
+            releaseModelInstance(*itr);
+        for (std::vector<StaticMapTree*>::iterator itr = iRetiredTrees.begin(); itr != iRetiredTrees.end(); ++itr)
+            delete *itr;
+        for (std::vector<InstanceTreeMap*>::iterator itr = iRetiredTreeMaps.begin(); itr != iRetiredTreeMaps.end(); ++itr)
+            delete *itr;
+
+        iRetiredInstances.clear();
+        iDeferredModelReleases.clear();
+        iRetiredTrees.clear();
+        iRetiredTreeMaps.clear();
+    }
+
     void VMapManager2::unloadMap(unsigned int mapId)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        TRINITY_GUARD(ACE_Thread_Mutex, MapTreesLock);
+        InstanceTreeMap* instanceTrees = iInstanceMapTrees.load();
+        InstanceTreeMap::iterator instanceTree = instanceTrees->find(mapId);
+        if (instanceTree != instanceTrees->end())
         {
             instanceTree->second->UnloadMap(this);
             if (instanceTree->second->numLoadedTiles() == 0)
-            {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(mapId);
-            }
+                _removeMapTree(mapId);
+            _reclaim();
         }
     }
 
     void VMapManager2::unloadMap(unsigned int mapId, int x, int y)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        TRINITY_GUARD(ACE_Thread_Mutex, MapTreesLock);
+        InstanceTreeMap* instanceTrees = iInstanceMapTrees.load();
+        InstanceTreeMap::iterator instanceTree = instanceTrees->find(mapId);
+        if (instanceTree != instanceTrees->end())
         {
             instanceTree->second->UnloadMapTile(x, y, this);
             if (instanceTree->second->numLoadedTiles() == 0)
-            {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(mapId);
-            }
+                _removeMapTree(mapId);
+            _reclaim();
         }
     }
 
@@ -137,14 +205,14 @@ namespace VMAP
         if (!isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
             return true;
 
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        ReadEpoch::Guard guard;
+        if (StaticMapTree const* instanceTree = _getMapTree(mapId))
         {
             Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
             Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
             if (pos1 != pos2)
             {
-                return instanceTree->second->isInLineOfSight(pos1, pos2);
+                return instanceTree->isInLineOfSight(pos1, pos2);
             }
         }
 
@@ -159,13 +227,13 @@ namespace VMAP
     {
         if (isLineOfSightCalcEnabled() && !DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
         {
-            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            ReadEpoch::Guard guard;
+            if (StaticMapTree const* instanceTree = _getMapTree(mapId))
             {
                 Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
                 Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
                 Vector3 resultPos;
-                bool result = instanceTree->second->getObjectHitPos(pos1, pos2, resultPos, modifyDist);
+                bool result = instanceTree->getObjectHitPos(pos1, pos2, resultPos, modifyDist);
                 resultPos = convertPositionToInternalRep(resultPos.x, resultPos.y, resultPos.z);
                 rx = resultPos.x;
                 ry = resultPos.y;
@@ -189,11 +257,11 @@ namespace VMAP
     {
         if (isHeightCalcEnabled() && !DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_HEIGHT))
         {
-            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            ReadEpoch::Guard guard;
+            if (StaticMapTree const* instanceTree = _getMapTree(mapId))
             {
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                float height = instanceTree->second->getHeight(pos, maxSearchDist);
+                float height = instanceTree->getHeight(pos, maxSearchDist);
                 if (!(height < G3D::inf()))
                     return height = VMAP_INVALID_HEIGHT_VALUE; // No height
 
@@ -208,11 +276,11 @@ namespace VMAP
     {
         if (!DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_AREAFLAG))
         {
-            InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(mapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            ReadEpoch::Guard guard;
+            if (StaticMapTree const* instanceTree = _getMapTree(mapId))
             {
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                bool result = instanceTree->second->getAreaInfo(pos, flags, adtId, rootId, groupId);
+                bool result = instanceTree->getAreaInfo(pos, flags, adtId, rootId, groupId);
                 // z is not touched by convertPositionToInternalRep(), so just copy
                 z = pos.z;
                 return result;
@@ -226,12 +294,12 @@ namespace VMAP
     {
         if (!DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LIQUIDSTATUS))
         {
-            InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(mapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            ReadEpoch::Guard guard;
+            if (StaticMapTree const* instanceTree = _getMapTree(mapId))
             {
                 LocationInfo info;
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                if (instanceTree->second->GetLocationInfo(pos, info))
+                if (instanceTree->GetLocationInfo(pos, info))
                 {
                     floor = info.ground_Z;
                     ASSERT(floor < std::numeric_limits<float>::max());
@@ -23,6 +23,8 @@
 #include "Dynamic/UnorderedMap.h"
 #include "Define.h"
 #include <ace/Thread_Mutex.h>
+#include <atomic>
+#include <vector>
 
 //===========================================================
 
@@ -36,6 +38,10 @@ For each map or map tile to load it reads a directory file that contains the Mod
 Each global map or instance has its own dynamic BSP-Tree.
 The loaded ModelContainers are included in one of these BSP-Trees.
 Additionally a table to match map ids and map names is used.
+
+Queries are lock free and may run from any number of map threads concurrently.
+Loads and unloads are serialized by MapTreesLock; they publish new trees and tree values
+atomically and free unlinked data only after all concurrent queries have finished (see ReadEpoch).
 */
 
 //===========================================================
@@ -49,6 +55,7 @@ namespace VMAP
 {
     class StaticMapTree;
     class WorldModel;
+    class ModelInstance;
 
     class ManagedModel
     {
@@ -71,12 +78,23 @@ namespace VMAP
         protected:
             // Tree to check collision
             ModelFileMap iLoadedModelFiles;
-            InstanceTreeMap iInstanceMapTrees;
+            // copy on write, replaced as a whole when a map tree is added or removed
+            std::atomic<InstanceTreeMap*> iInstanceMapTrees;
             // Mutex for iLoadedModelFiles
             ACE_Thread_Mutex LoadedModelFilesLock;
+            // Mutex serializing map and tile loads/unloads, queries never take it
+            ACE_Thread_Mutex MapTreesLock;
+
+            // data unlinked by an unload, freed by _reclaim() once no query can reach it
+            std::vector<ModelInstance*> iRetiredInstances;
+            std::vector<std::string> iDeferredModelReleases;
+            std::vector<StaticMapTree*> iRetiredTrees;
+            std::vector<InstanceTreeMap*> iRetiredTreeMaps;
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
-            /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
+            void _removeMapTree(uint32 mapId);
+            void _reclaim();
+            StaticMapTree const* _getMapTree(uint32 mapId) const;
 
         public:
             // public for debug
@@ -105,6 +123,9 @@ namespace VMAP
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
             void releaseModelInstance(const std::string& filename);
+            // for StaticMapTree unloads, only valid while MapTreesLock is held
+            void releaseModelInstanceDeferred(const std::string& filename) { iDeferredModelReleases.push_back(filename); }
+            void retireModelInstance(ModelInstance* instance) { if (instance) iRetiredInstances.push_back(instance); }
 
             // what's the use of this? o.O
             virtual std::string getDirFileName(unsigned int mapId, int /*x*/, int /*y*/) const
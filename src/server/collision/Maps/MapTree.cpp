@@ -42,50 +42,59 @@ namespace VMAP
     class MapRayCallback
     {
         public:
-            MapRayCallback(ModelInstance* val): prims(val), hit(false) {}
+            MapRayCallback(TreeValueSlot* val): prims(val), hit(false) {}
             bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool pStopAtFirstHit=true)
             {
-                bool result = prims[entry].intersectRay(ray, distance, pStopAtFirstHit);
+                ModelInstance const* prim = prims[entry].load();
+                if (!prim)
+                    return false;
+                bool result = prim->intersectRay(ray, distance, pStopAtFirstHit);
                 if (result)
                     hit = true;
                 return result;
             }
         bool didHit() { return hit; }
     protected:
-        ModelInstance* prims;
+        TreeValueSlot* prims;
         bool hit;
     };
 
     class AreaInfoCallback
     {
         public:
-            AreaInfoCallback(ModelInstance* val): prims(val) {}
+            AreaInfoCallback(TreeValueSlot* val): prims(val) {}
             void operator()(const Vector3& point, uint32 entry)
             {
+                ModelInstance const* prim = prims[entry].load();
+                if (!prim)
+                    return;
 #ifdef VMAP_DEBUG
-                sLog->outDebug(LOG_FILTER_MAPS, "AreaInfoCallback: trying to intersect '%s'", prims[entry].name.c_str());
+                sLog->outDebug(LOG_FILTER_MAPS, "AreaInfoCallback: trying to intersect '%s'", prim->name.c_str());
 #endif
-                prims[entry].intersectPoint(point, aInfo);
+                prim->intersectPoint(point, aInfo);
             }
 
-            ModelInstance* prims;
+            TreeValueSlot* prims;
             AreaInfo aInfo;
     };
 
     class LocationInfoCallback
     {
         public:
-            LocationInfoCallback(ModelInstance* val, LocationInfo &info): prims(val), locInfo(info), result(false) {}
+            LocationInfoCallback(TreeValueSlot* val, LocationInfo &info): prims(val), locInfo(info), result(false) {}
             void operator()(const Vector3& point, uint32 entry)
             {
+                ModelInstance const* prim = prims[entry].load();
+                if (!prim)
+                    return;
 #ifdef VMAP_DEBUG
-                sLog->outDebug(LOG_FILTER_MAPS, "LocationInfoCallback: trying to intersect '%s'", prims[entry].name.c_str());
+                sLog->outDebug(LOG_FILTER_MAPS, "LocationInfoCallback: trying to intersect '%s'", prim->name.c_str());
 #endif
-                if (prims[entry].GetLocationInfo(point, locInfo))
+                if (prim->GetLocationInfo(point, locInfo))
                     result = true;
             }
 
-            ModelInstance* prims;
+            TreeValueSlot* prims;
             LocationInfo &locInfo;
             bool result;
     };
@@ -126,7 +135,7 @@ namespace VMAP
     }
 
     StaticMapTree::StaticMapTree(uint32 mapID, const std::string &basePath)
-        : iMapID(mapID), iIsTiled(false), iTreeValues(0), iBasePath(basePath)
+        : iMapID(mapID), iIsTiled(false), iTreeValues(0), iNTreeValues(0), iBasePath(basePath)
     {
         if (iBasePath.length() > 0 && iBasePath[iBasePath.length()-1] != '/' && iBasePath[iBasePath.length()-1] != '\\')
         {
@@ -138,6 +147,8 @@ namespace VMAP
     //! Make sure to call unloadMap() to unregister acquired model references before destroying
     StaticMapTree::~StaticMapTree()
     {
+        for (uint32 i = 0; iTreeValues && i < iNTreeValues; ++i)
+            delete iTreeValues[i].load();
         delete[] iTreeValues;
     }
 
@@ -298,7 +309,9 @@ namespace VMAP
             if (success)
             {
                 iNTreeValues = iTree.primCount();
-                iTreeValues = new ModelInstance[iNTreeValues];
+                iTreeValues = new TreeValueSlot[iNTreeValues];
+                for (uint32 i = 0; i < iNTreeValues; ++i)
+                    iTreeValues[i].store(NULL);
             }
 
             if (success && !readChunk(rf, chunk, "GOBJ", 4)) success = false;
@@ -315,7 +328,7 @@ namespace VMAP
                 if (model)
                 {
                     // assume that global model always is the first and only tree value (could be improved...)
-                    iTreeValues[0] = ModelInstance(spawn, model);
+                    iTreeValues[0].store(new ModelInstance(spawn, model));
                     iLoadedSpawns[0] = 1;
                 }
                 else
@@ -336,9 +349,13 @@ namespace VMAP
     {
         for (loadedSpawnMap::iterator i = iLoadedSpawns.begin(); i != iLoadedSpawns.end(); ++i)
         {
-            iTreeValues[i->first].setUnloaded();
+            // unlink first, queries still running may hold the instance until the manager reclaims it
+            ModelInstance* instance = iTreeValues[i->first].exchange(NULL);
+            if (!instance)
+                continue;
             for (uint32 refCount = 0; refCount < i->second; ++refCount)
-                vm->releaseModelInstance(iTreeValues[i->first].name);
+                vm->releaseModelInstanceDeferred(instance->name);
+            vm->retireModelInstance(instance);
         }
         iLoadedSpawns.clear();
         iLoadedTiles.clear();
@@ -399,16 +416,17 @@ namespace VMAP
                                 continue;
                             }
 #endif
-                            iTreeValues[referencedVal] = ModelInstance(spawn, model);
+                            // fully construct the instance before queries can see it
+                            iTreeValues[referencedVal].store(new ModelInstance(spawn, model));
                             iLoadedSpawns[referencedVal] = 1;
                         }
                         else
                         {
                             ++iLoadedSpawns[referencedVal];
 #ifdef VMAP_DEBUG
-                            if (iTreeValues[referencedVal].ID != spawn.ID)
+                            if (iTreeValues[referencedVal].load()->ID != spawn.ID)
                                 sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::LoadMapTile() : trying to load wrong spawn in node");
-                            else if (iTreeValues[referencedVal].name != spawn.name)
+                            else if (iTreeValues[referencedVal].load()->name != spawn.name)
                                 sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::LoadMapTile() : name collision on GUID=%u", spawn.ID);
 #endif
                         }
@@ -456,8 +474,8 @@ namespace VMAP
                     result = ModelSpawn::readFromFile(tf, spawn);
                     if (result)
                     {
-                        // release model instance
-                        vm->releaseModelInstance(spawn.name);
+                        // release model instance once no query can reach it anymore
+                        vm->releaseModelInstanceDeferred(spawn.name);
 
                         // update tree
                         uint32 referencedNode;
@@ -470,7 +488,7 @@ namespace VMAP
                             sLog->outError(LOG_FILTER_GENERAL, "StaticMapTree::UnloadMapTile() : trying to unload non-referenced model '%s' (ID:%u)", spawn.name.c_str(), spawn.ID);
                             else if (--iLoadedSpawns[referencedNode] == 0)
                             {
-                                iTreeValues[referencedNode].setUnloaded();
+                                vm->retireModelInstance(iTreeValues[referencedNode].exchange(NULL));
                                 iLoadedSpawns.erase(referencedNode);
                             }
                         }
@@ -22,6 +22,7 @@
 #include "Define.h"
 #include "Dynamic/UnorderedMap.h"
 #include "BoundingIntervalHierarchy.h"
+#include <atomic>
 
 namespace VMAP
 {
@@ -29,6 +30,9 @@ namespace VMAP
     class GroupModel;
     class VMapManager2;
 
+    // tree entries are published and unlinked atomically, queries run without locks (see ReadEpoch)
+    typedef std::atomic<ModelInstance*> TreeValueSlot;
+
     struct LocationInfo
     {
         LocationInfo(): hitInstance(0), hitModel(0), ground_Z(-G3D::inf()) {};
@@ -45,7 +49,7 @@ namespace VMAP
             uint32 iMapID;
             bool iIsTiled;
             BIH iTree;
-            ModelInstance* iTreeValues; // the tree entries
+            TreeValueSlot* iTreeValues; // the tree entries
             uint32 iNTreeValues;
 
             // Store all the map tile idents that are loaded for that map
@@ -53,6 +57,7 @@ namespace VMAP
             // empty tiles have no tile file, hence map with bool instead of just a set (consistency check)
             loadedTileMap iLoadedTiles;
             // stores <tree_index, reference_count> to invalidate tree values, unload map, and to be able to report errors
+            // only touched by VMapManager2 with its load lock held
             loadedSpawnMap iLoadedSpawns;
             std::string iBasePath;
 
@@ -409,12 +409,14 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    AddToSearchIndex(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    RemoveFromSearchIndex(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -425,6 +427,129 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry
     return wasInMap;
 }
 
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry* auction)
+{
+    // auctions without item are never listed
+    Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow);
+    if (!item)
+        return;
+
+    AuctionSearchEntry& entry = SearchEntries[auction->Id];
+    entry.auction = auction;
+    entry.proto = item->GetTemplate();
+    entry.randomPropertyId = item->GetItemRandomPropertyId();
+
+    ClassIndex[entry.proto->Class].insert(auction->Id);
+    SubClassIndex[entry.proto->Class << 16 | entry.proto->SubClass].insert(auction->Id);
+    InventoryTypeIndex[entry.proto->InventoryType].insert(auction->Id);
+    QualityIndex[entry.proto->Quality].insert(auction->Id);
+    LevelIndex[entry.proto->RequiredLevel].insert(auction->Id);
+
+    std::wstring name;
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        if (NameIndexBuilt[i] && BuildSearchName(entry, LocaleConstant(i), name))
+            NameIndex[i][name].insert(auction->Id);
+}
+
+static void EraseFromIndex(std::map<uint32, std::set<uint32> >& index, uint32 key, uint32 auctionId)
+{
+    std::map<uint32, std::set<uint32> >::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    itr->second.erase(auctionId);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+void AuctionHouseObject::RemoveFromSearchIndex(uint32 auctionId)
+{
+    AuctionSearchMap::iterator itr = SearchEntries.find(auctionId);
+    if (itr == SearchEntries.end())
+        return;
+
+    AuctionSearchEntry const& entry = itr->second;
+    EraseFromIndex(ClassIndex, entry.proto->Class, auctionId);
+    EraseFromIndex(SubClassIndex, entry.proto->Class << 16 | entry.proto->SubClass, auctionId);
+    EraseFromIndex(InventoryTypeIndex, entry.proto->InventoryType, auctionId);
+    EraseFromIndex(QualityIndex, entry.proto->Quality, auctionId);
+    EraseFromIndex(LevelIndex, entry.proto->RequiredLevel, auctionId);
+
+    std::wstring name;
+    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+    {
+        if (!NameIndexBuilt[i] || !BuildSearchName(entry, LocaleConstant(i), name))
+            continue;
+
+        AuctionNameIndex::iterator nameItr = NameIndex[i].find(name);
+        if (nameItr == NameIndex[i].end())
+            continue;
+
+        nameItr->second.erase(auctionId);
+        if (nameItr->second.empty())
+            NameIndex[i].erase(nameItr);
+    }
+
+    SearchEntries.erase(itr);
+}
+
+AuctionHouseObject::AuctionNameIndex const& AuctionHouseObject::GetNameIndex(LocaleConstant locale)
+{
+    if (!NameIndexBuilt[locale])
+    {
+        std::wstring name;
+        for (AuctionSearchMap::const_iterator itr = SearchEntries.begin(); itr != SearchEntries.end(); ++itr)
+            if (BuildSearchName(itr->second, locale, name))
+                NameIndex[locale][name].insert(itr->first);
+
+        NameIndexBuilt[locale] = true;
+    }
+
+    return NameIndex[locale];
+}
+
+bool AuctionHouseObject::BuildSearchName(AuctionSearchEntry const& entry, LocaleConstant locale, std::wstring& wname)
+{
+    std::string name = entry.proto->Name1;
+    if (name.empty())
+        return false;
+
+    // local name
+    if (ItemLocale const* il = sObjectMgr->GetItemLocale(entry.proto->ItemId))
+        ObjectMgr::GetLocaleString(il->Name, locale, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    if (entry.randomPropertyId)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(entry.randomPropertyId))
+        {
+            char* const* temp = itemRandProp->nameSuffix;
+
+            // dbc local name
+            if (temp)
+            {
+                // Append the suffix (ie: of the Monkey) to the name using localization
+                // or default enUS if localization is invalid
+                int locdbc_idx = sWorld->GetAvailableDbcLocale(locale);
+                name += ' ';
+                name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
+            }
+        }
+    }
+
+    if (!Utf8toWStr(name, wname))
+        return false;
+
+    // converting to lower case
+    wstrToLower(wname);
+    return true;
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld->GetGameTime();
@@ -515,17 +640,99 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
+    uint8 levelmaxIndexed = levelmax != 0x00 ? levelmax : 0xFF;
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    // Start from the smallest index bucket matching the filters, an empty bucket means no results
+    AuctionIdSet const* bucket = NULL;
+    size_t candidateCount = SearchEntries.size();
+    AuctionIndex const* indexes[3] = { &InventoryTypeIndex, &QualityIndex, NULL };
+    uint32 keys[3] = { inventoryType, quality, 0xffffffff };
+    if (itemClass != 0xffffffff)
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
+        indexes[2] = itemSubClass != 0xffffffff ? &SubClassIndex : &ClassIndex;
+        keys[2] = itemSubClass != 0xffffffff ? (itemClass << 16 | itemSubClass) : itemClass;
+    }
+
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        if (!indexes[i] || keys[i] == 0xffffffff)
             continue;
 
-        ItemTemplate const* proto = item->GetTemplate();
+        AuctionIndex::const_iterator itr = indexes[i]->find(keys[i]);
+        if (itr == indexes[i]->end())
+            return;
+
+        if (itr->second.size() < candidateCount)
+        {
+            bucket = &itr->second;
+            candidateCount = bucket->size();
+        }
+    }
+
+    // Level range spans several buckets, use it only when it is the most selective filter
+    bool levelRange = false;
+    if (levelmin != 0x00)
+    {
+        size_t levelCount = 0;
+        for (AuctionIndex::const_iterator itr = LevelIndex.lower_bound(levelmin); itr != LevelIndex.end() && itr->first <= levelmaxIndexed; ++itr)
+            levelCount += itr->second.size();
+
+        if (!levelCount)
+            return;
+
+        if (levelCount < candidateCount)
+        {
+            levelRange = true;
+            candidateCount = levelCount;
+        }
+    }
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    // Every distinct name is checked once, no need to do any of this if no search term was entered
+    std::vector<uint32> nameMatches;
+    if (!wsearchedname.empty())
+    {
+        AuctionNameIndex const& nameIndex = GetNameIndex(player->GetSession()->GetSessionDbLocaleIndex());
+        for (AuctionNameIndex::const_iterator itr = nameIndex.begin(); itr != nameIndex.end(); ++itr)
+            if (itr->first.find(wsearchedname) != std::wstring::npos)
+                nameMatches.insert(nameMatches.end(), itr->second.begin(), itr->second.end());
+
+        if (nameMatches.empty())
+            return;
+
+        std::sort(nameMatches.begin(), nameMatches.end());
+    }
+
+    std::vector<uint32> candidates;
+    if (!nameMatches.empty() && nameMatches.size() <= candidateCount)
+        candidates.swap(nameMatches);
+    else if (levelRange)
+    {
+        candidates.reserve(candidateCount);
+        for (AuctionIndex::const_iterator itr = LevelIndex.lower_bound(levelmin); itr != LevelIndex.end() && itr->first <= levelmaxIndexed; ++itr)
+            candidates.insert(candidates.end(), itr->second.begin(), itr->second.end());
+
+        std::sort(candidates.begin(), candidates.end());
+    }
+    else if (bucket)
+        candidates.assign(bucket->begin(), bucket->end());
+    else
+    {
+        candidates.reserve(AuctionsMap.size());
+        for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+            candidates.push_back(itr->first);
+    }
+
+    // Check the remaining filters against the cached templates, items are only needed for usable
+    std::vector<AuctionEntry*> matches;
+    for (std::vector<uint32>::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+    {
+        AuctionSearchMap::const_iterator entryItr = SearchEntries.find(*itr);
+        if (entryItr == SearchEntries.end())
+            continue;
+
+        AuctionSearchEntry const& entry = entryItr->second;
+        ItemTemplate const* proto = entry.proto;
 
         if (itemClass != 0xffffffff && proto->Class != itemClass)
             continue;
@@ -542,61 +749,25 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
             continue;
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        if (!nameMatches.empty() && !std::binary_search(nameMatches.begin(), nameMatches.end(), *itr))
             continue;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
+        if (usable != 0x00)
         {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* const* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
+            Item* item = sAuctionMgr->GetAItem(entry.auction->itemGUIDLow);
+            if (!item || player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
         }
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        ++totalcount;
+        matches.push_back(entry.auction);
+    }
+
+    // Matches are in auction id order, the requested page is taken directly
+    totalcount = matches.size();
+    for (uint32 i = listfrom; i < matches.size() && count < 50; ++i)
+    {
+        ++count;
+        matches[i]->BuildAuctionInfo(data);
     }
 }
 
@@ -28,6 +28,7 @@
 class Item;
 class Player;
 class WorldPacket;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
@@ -91,12 +92,25 @@ struct AuctionEntry
 
 };
 
+// search data of an auction, cached when the auction is added
+struct AuctionSearchEntry
+{
+    AuctionEntry* auction;
+    ItemTemplate const* proto;
+    int32 randomPropertyId;
+};
+
 //this class is used as auctionhouse instance
 class AuctionHouseObject
 {
   public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject()
+    {
+        next = AuctionsMap.begin();
+        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+            NameIndexBuilt[i] = false;
+    }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -130,8 +144,28 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    typedef std::set<uint32> AuctionIdSet;                  // ordered by auction id, like AuctionsMap
+    typedef std::map<uint32, AuctionIdSet> AuctionIndex;
+    typedef std::map<std::wstring, AuctionIdSet> AuctionNameIndex;
+    typedef UNORDERED_MAP<uint32, AuctionSearchEntry> AuctionSearchMap;
+
+    void AddToSearchIndex(AuctionEntry* auction);
+    void RemoveFromSearchIndex(uint32 auctionId);
+    AuctionNameIndex const& GetNameIndex(LocaleConstant locale);
+    static bool BuildSearchName(AuctionSearchEntry const& entry, LocaleConstant locale, std::wstring& name);
+
     AuctionEntryMap AuctionsMap;
 
+    // secondary indexes for BuildListAuctionItems, maintained on add and remove
+    AuctionSearchMap SearchEntries;
+    AuctionIndex ClassIndex;                                // item class
+    AuctionIndex SubClassIndex;                             // item class << 16 | item subclass
+    AuctionIndex InventoryTypeIndex;
+    AuctionIndex QualityIndex;
+    AuctionIndex LevelIndex;                                // required level
+    AuctionNameIndex NameIndex[TOTAL_LOCALES];              // lower case name with random property suffix, built at first search in a locale
+    bool NameIndexBuilt[TOTAL_LOCALES];
+
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
 };
@@ -81,6 +81,18 @@ void BattlegroundMgr::DeleteAllBattlegrounds()
 // used to update running battlegrounds, and delete finished ones
 void BattlegroundMgr::Update(uint32 diff)
 {
+    // players removed by battleground updates, done here because leaving touches groups, arena teams and queues
+    PlayerRemovalScheduler removals;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_SchedulerLock);
+        std::swap(removals, m_PlayerRemovalScheduler);
+    }
+
+    for (PlayerRemovalScheduler::const_iterator itr = removals.begin(); itr != removals.end(); ++itr)
+        if (itr->first->IsPlayerInBattleground(itr->second))
+            itr->first->RemovePlayerAtLeave(itr->second, true, true);
+
+    // battlegrounds are updated by their BattlegroundMap, the ones without a map here
     for (BattlegroundDataContainer::iterator itr1 = bgDataStore.begin(); itr1 != bgDataStore.end(); ++itr1)
     {
         BattlegroundContainer& bgs = itr1->second.m_Battlegrounds;
@@ -91,7 +103,11 @@ void BattlegroundMgr::Update(uint32 diff)
             itrDelete = itr++;
             Battleground* bg = itrDelete->second;
 
-            bg->Update(diff);
+            // the map is only created when the first invited player enters and goes away
+            // when it unloads, the invite timers and the end timer still have to run
+            if (!bg->FindBgMap())
+                bg->Update(diff);
+
             if (bg->ToBeDeleted())
             {
                 itrDelete->second = NULL;
@@ -110,11 +126,14 @@ void BattlegroundMgr::Update(uint32 diff)
         m_BattlegroundQueues[qtype].UpdateEvents(diff);
 
     // update scheduled queues
-    if (!m_QueueUpdateScheduler.empty())
+    std::vector<uint64> scheduled;
     {
-        std::vector<uint64> scheduled;
+        TRINITY_GUARD(ACE_Thread_Mutex, m_SchedulerLock);
         std::swap(scheduled, m_QueueUpdateScheduler);
+    }
 
+    if (!scheduled.empty())
+    {
         for (uint8 i = 0; i < scheduled.size(); i++)
         {
             uint32 arenaMMRating = scheduled[i] >> 32;
@@ -934,13 +953,21 @@ void BattlegroundMgr::SetHolidayWeekends(uint32 mask)
 
 void BattlegroundMgr::ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 arenaType, BattlegroundQueueTypeId bgQueueTypeId, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id)
 {
-    //This method must be atomic, TODO add mutex
     //we will use only 1 number created of bgTypeId and bracket_id
     uint64 const scheduleId = ((uint64)arenaMatchmakerRating << 32) | (arenaType << 24) | (bgQueueTypeId << 16) | (bgTypeId << 8) | bracket_id;
+
+    // called from battleground updates in map threads too
+    TRINITY_GUARD(ACE_Thread_Mutex, m_SchedulerLock);
     if (std::find(m_QueueUpdateScheduler.begin(), m_QueueUpdateScheduler.end(), scheduleId) == m_QueueUpdateScheduler.end())
         m_QueueUpdateScheduler.push_back(scheduleId);
 }
 
+void BattlegroundMgr::SchedulePlayerRemoval(Battleground* bg, uint64 guid)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_SchedulerLock);
+    m_PlayerRemovalScheduler.push_back(std::make_pair(bg, guid));
+}
+
 uint32 BattlegroundMgr::GetMaxRatingDifference() const
 {
     // this is for stupid people who can't use brain and set max rating difference to 0
@@ -1086,11 +1113,13 @@ BGFreeSlotQueueContainer& BattlegroundMgr::GetBGFreeSlotQueueStore(BattlegroundT
 
 void BattlegroundMgr::AddToBGFreeSlotQueue(BattlegroundTypeId bgTypeId, Battleground* bg)
 {
+    TRINITY_GUARD(ACE_Thread_Mutex, m_BGFreeSlotQueueLock);
     bgDataStore[bgTypeId].BGFreeSlotQueue.push_front(bg);
 }
 
 void BattlegroundMgr::RemoveFromBGFreeSlotQueue(BattlegroundTypeId bgTypeId, uint32 instanceId)
 {
+    TRINITY_GUARD(ACE_Thread_Mutex, m_BGFreeSlotQueueLock);
     BGFreeSlotQueueContainer& queues = bgDataStore[bgTypeId].BGFreeSlotQueue;
     for (BGFreeSlotQueueContainer::iterator itr = queues.begin(); itr != queues.end(); ++itr)
         if ((*itr)->GetInstanceID() == instanceId)
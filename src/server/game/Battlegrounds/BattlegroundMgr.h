@@ -104,6 +104,8 @@ class BattlegroundMgr
         /* Battleground queues */
         BattlegroundQueue& GetBattlegroundQueue(BattlegroundQueueTypeId bgQueueTypeId) { return m_BattlegroundQueues[bgQueueTypeId]; }
         void ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 arenaType, BattlegroundQueueTypeId bgQueueTypeId, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id);
+        // Battleground::Update runs in map update threads, players it removes are handed to the next BattlegroundMgr::Update
+        void SchedulePlayerRemoval(Battleground* bg, uint64 guid);
         uint32 GetPrematureFinishTime() const;
 
         void ToggleArenaTesting();
@@ -149,6 +151,10 @@ class BattlegroundMgr
         BattlegroundSelectionWeightMap m_ArenaSelectionWeights;
         BattlegroundSelectionWeightMap m_BGSelectionWeights;
         std::vector<uint64> m_QueueUpdateScheduler;
+        typedef std::vector<std::pair<Battleground*, uint64> > PlayerRemovalScheduler;
+        PlayerRemovalScheduler m_PlayerRemovalScheduler;
+        ACE_Thread_Mutex m_SchedulerLock;                   // guards m_QueueUpdateScheduler and m_PlayerRemovalScheduler
+        ACE_Thread_Mutex m_BGFreeSlotQueueLock;             // battlegrounds of different maps add and remove themselves concurrently
         uint32 m_NextRatedArenaUpdate;
         time_t m_NextAutoDistributionTime;
         uint32 m_AutoDistributionTimeChecker;
@@ -59,6 +59,9 @@ BattlegroundQueue::~BattlegroundQueue()
                 delete (*itr);
             m_QueuedGroups[i][j].clear();
         }
+
+        for (uint32 j = 0; j < BG_TEAMS_COUNT; ++j)
+            m_RatingIndex[i][j].clear();
     }
 }
 
@@ -196,6 +199,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     {
         //ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_Lock);
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        if (isRated)
+            AddToRatingIndex(--m_QueuedGroups[bracketId][index].end(), bracketId);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -377,6 +382,8 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
+        if (group->IsRated && !group->IsInvitedToBGInstanceGUID)
+            RemoveFromRatingIndex(group_itr, BattlegroundBracketId(bracket_id));
         m_QueuedGroups[bracket_id][index].erase(group_itr);
         delete group;
         return;
@@ -491,6 +498,57 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     return false;
 }
 
+void BattlegroundQueue::AddToRatingIndex(GroupsQueueType::iterator group, BattlegroundBracketId bracket_id)
+{
+    uint32 index = ((*group)->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
+    m_RatingIndex[bracket_id][index].insert(group);
+}
+
+// must be called before the group is invited, invitation may change its team
+void BattlegroundQueue::RemoveFromRatingIndex(GroupsQueueType::iterator group, BattlegroundBracketId bracket_id)
+{
+    uint32 index = ((*group)->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
+    m_RatingIndex[bracket_id][index].erase(group);
+}
+
+// rejects the teams of the given arena team, if any
+class RatedGroupSkip
+{
+    public:
+        explicit RatedGroupSkip(GroupQueueInfo const* opponent) : _opponent(opponent) { }
+        bool operator() (BattlegroundQueue::GroupsQueueType::iterator const& itr) const { return _opponent && (*itr)->ArenaTeamId == _opponent->ArenaTeamId; }
+    private:
+        GroupQueueInfo const* _opponent;
+};
+
+/*
+This function selects the rated team that waits longest in given faction queue and either
+has its rating in [minRating, maxRating] or joined before discardTime
+when opponent is set, teams of the same arena team are skipped
+*/
+bool BattlegroundQueue::SelectRatedGroup(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* opponent, GroupsQueueType::iterator& selected)
+{
+    RatedGroupSkip skip(opponent);
+
+    // rated teams are only appended to the queue, so the first one not yet invited has the longest wait time
+    // if its ratings are already discarded, it is the one to select
+    for (GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][index].begin(); itr != m_QueuedGroups[bracket_id][index].end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || skip(itr))
+            continue;
+
+        if ((*itr)->JoinTime < discardTime)
+        {
+            selected = itr;
+            return true;
+        }
+        break;
+    }
+
+    // otherwise look only at teams inside the rating window
+    return m_RatingIndex[bracket_id][index].selectOldest(minRating, maxRating, skip, selected);
+}
+
 /*
 This function is inviting players to already running battlegrounds
 Invitation type is based on config file
@@ -896,51 +954,29 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
         uint32 discardTime = getMSTime() - sBattlegroundMgr->GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        GroupsQueueType::iterator teams[BG_TEAMS_COUNT];
         uint8 found = 0;
-        uint8 team = 0;
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
-        {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
-            {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
-            }
-        }
+            if (SelectRatedGroup(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, NULL, teams[found]))
+                ++found;
 
         if (!found)
             return;
 
+        // both teams may come from the same faction queue
         if (found == 1)
         {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
+            uint32 index = ((*teams[0])->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
+            if (SelectRatedGroup(bracket_id, index, arenaMinRating, arenaMaxRating, discardTime, *teams[0], teams[found]))
+                ++found;
         }
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
+            GroupQueueInfo* aTeam = *teams[TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = *teams[TEAM_HORDE];
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
             {
@@ -948,6 +984,9 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
                 return;
             }
 
+            RemoveFromRatingIndex(teams[TEAM_ALLIANCE], bracket_id);
+            RemoveFromRatingIndex(teams[TEAM_HORDE], bracket_id);
+
             aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
             hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
             aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
@@ -957,15 +996,9 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
 
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->Team != ALLIANCE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].splice(m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin(), m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE], teams[TEAM_ALLIANCE]);
             if (hTeam->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].splice(m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin(), m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE], teams[TEAM_HORDE]);
 
             arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
             arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
@@ -23,8 +23,10 @@
 #include "DBCEnums.h"
 #include "Battleground.h"
 #include "EventProcessor.h"
+#include "RatingIndex.h"
 
-#include <deque>
+#include <list>
+#include <map>
 
 //this container can't be deque, because deque doesn't like removing the last element - if you remove it, it invalidates next iterator and crash appears
 typedef std::list<Battleground*> BGFreeSlotQueueContainer;
@@ -88,8 +90,8 @@ class BattlegroundQueue
         typedef std::map<uint64, PlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_QueuedPlayers;
 
-        //we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::deque<GroupQueueInfo*> GroupsQueueType;
+        //we need constant add to begin and constant remove / add from the end, a list also keeps the iterators of the rating index valid
+        typedef std::list<GroupQueueInfo*> GroupsQueueType;
 
         /*
         This two dimensional array is used to store All queued groups
@@ -102,6 +104,16 @@ class BattlegroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        struct RatedGroupOrder
+        {
+            static uint32 GetRating(GroupsQueueType::iterator const& itr) { return (*itr)->ArenaMatchmakerRating; }
+            static uint32 GetJoinTime(GroupsQueueType::iterator const& itr) { return (*itr)->JoinTime; }
+        };
+
+        // rated teams not yet invited, per bracket and faction queue, ordered by matchmaker rating
+        typedef Trinity::RatingIndex<GroupsQueueType::iterator, RatedGroupOrder> RatingIndexType;
+        RatingIndexType m_RatingIndex[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -123,6 +135,9 @@ class BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+        void AddToRatingIndex(GroupsQueueType::iterator group, BattlegroundBracketId bracket_id);
+        void RemoveFromRatingIndex(GroupsQueueType::iterator group, BattlegroundBracketId bracket_id);
+        bool SelectRatedGroup(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* opponent, GroupsQueueType::iterator& selected);
         uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
@@ -25,6 +25,7 @@
 #include "DatabaseEnv.h"
 #include "AccountMgr.h"
 #include "Player.h"
+#include "SharedWorldPacket.h"
 
 Channel::Channel(std::string const& name, uint32 channelId, uint32 team, bool custom):
     _announce(true),
@@ -555,7 +556,7 @@ void Channel::List(Player const* player)
         return;
     }
 
-    sLog->outDebug(LOG_FILTER_CHATSYS, "SMSG_CHANNEL_LIST %s Channel: %s",
+    TC_LOG_DEBUG(LOG_FILTER_CHATSYS, "SMSG_CHANNEL_LIST %s Channel: %s",
         player->GetSession()->GetPlayerInfo().c_str(), GetName().c_str());
 
     WorldPacket data(SMSG_CHANNEL_LIST, 1+(GetName().size()+1)+1+4+playersStore.size()*(8+1));
@@ -762,20 +763,38 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket* data, uint64 guid)
+void Channel::FindMembers(std::vector<Player*>& players, uint64 except) const
 {
+    std::vector<uint64> guids;
+    guids.reserve(playersStore.size());
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (Player* player = ObjectAccessor::FindPlayer(i->first))
+        if (i->first != except)
+            guids.push_back(i->first);
+
+    ObjectAccessor::FindPlayers(guids, players);
+}
+
+void Channel::SendToAll(WorldPacket* data, uint64 guid)
+{
+    std::vector<Player*> players;
+    FindMembers(players);
+
+    SharedWorldPacketSender sender(data);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        if (Player* player = *itr)
             if (!guid || !player->GetSocial()->HasIgnore(GUID_LOPART(guid)))
-                player->GetSession()->SendPacket(data);
+                sender.SendTo(player->GetSession());
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (i->first != who)
-            if (Player* player = ObjectAccessor::FindPlayer(i->first))
-                player->GetSession()->SendPacket(data);
+    std::vector<Player*> players;
+    FindMembers(players, who);
+
+    SharedWorldPacketSender sender(data);
+    for (std::vector<Player*>::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        if (Player* player = *itr)
+            sender.SendTo(player->GetSession());
 }
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
@@ -99,6 +99,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatManager* threatManager,
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
+    iThreatSequence = 0;
     link(refUnit, threatManager);
 }
 
@@ -261,6 +263,8 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatHeap.clear();
+    iReferences.clear();
 }
 
 //============================================================
@@ -270,15 +274,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference *ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return NULL;
+    ReferenceMap::const_iterator itr = iReferences.find(victim->GetGUID());
+    return itr != iReferences.end() ? itr->second : NULL;
 }
 
 //============================================================
@@ -300,13 +297,47 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
         ref->addThreatPercent(percent);
 }
 
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    hostileRef->iListPosition = iThreatList.insert(iThreatList.end(), hostileRef);
+    hostileRef->iThreatSequence = ++iThreatSequence;
+    iReferences[hostileRef->getUnitGuid()] = hostileRef;
+    iThreatHeap.push(hostileRef);
+
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    ASSERT(iThreatHeap.contains(hostileRef));
+
+    iThreatList.erase(hostileRef->iListPosition);
+    iReferences.erase(hostileRef->getUnitGuid());
+    iThreatHeap.erase(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::updateThreat(HostileReference* hostileRef)
+{
+    ASSERT(iThreatHeap.contains(hostileRef));
+
+    iThreatHeap.update(hostileRef);
+
+    iDirty = true;
+}
+
 //============================================================
 // Check if the list is dirty and sort if necessary
 
-void ThreatContainer::update()
+void ThreatContainer::update() const
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+        iThreatList.sort(&ThreatHeapOrder::IsBefore);
 
     iDirty = false;
 }
@@ -317,16 +348,18 @@ void ThreatContainer::update()
 
 HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileReference* currentVictim) const
 {
+    if (iThreatHeap.empty())
+        return NULL;
+
     HostileReference* currentRef = NULL;
     bool found = false;
     bool noPriorityTargetFound = false;
 
-    ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
-    for (ThreatContainer::StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    // visit the references in threat order without sorting all of them
+    iVictimWalker.start(iThreatHeap);
+    while (!iVictimWalker.done())
     {
-        currentRef = (*iter);
+        currentRef = iVictimWalker.next();
 
         Unit* target = currentRef->getTarget();
         ASSERT(target);                                     // if the ref has status online the target must be there !
@@ -334,19 +367,18 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
         // some units are prefered in comparison to others
         if (!noPriorityTargetFound && (target->IsImmunedToDamage(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE)))
         {
-            if (iter != lastRef)
+            if (!iVictimWalker.done())
             {
                 // current victim is a second choice target, so don't compare threat with it below
                 if (currentRef == currentVictim)
                     currentVictim = NULL;
-                ++iter;
                 continue;
             }
             else
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 noPriorityTargetFound = true;
-                iter = iThreatList.begin();
+                iVictimWalker.start(iThreatHeap);
                 continue;
             }
         }
@@ -355,7 +387,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
         {
             if (currentVictim)                              // select 1.3/1.1 better target in comparison current target
             {
-                // list sorted and and we check current target, then this is best case
+                // references visited in threat order and we check current target, then this is best case
                 if (currentVictim == currentRef || currentRef->getThreat() <= 1.1f * currentVictim->getThreat())
                 {
                     if (currentVictim != currentRef && attacker->canCreatureAttack(currentVictim->getTarget()))
@@ -379,7 +411,6 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
                 break;
             }
         }
-        ++iter;
     }
     if (!found)
         currentRef = NULL;
@@ -465,7 +496,6 @@ void ThreatManager::modifyThreatPercent(Unit* victim, int32 percent)
 
 Unit* ThreatManager::getHostilTarget()
 {
-    iThreatContainer.update();
     HostileReference* nextVictim = iThreatContainer.selectNextVictim(getOwner()->ToCreature(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != NULL ? getCurrentVictim()->getTarget() : NULL;
@@ -509,9 +539,11 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostilRef->isOnline())
+                iThreatContainer.updateThreat(hostilRef);
+            else
+                iThreatOfflineContainer.updateThreat(hostilRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostilRef->isOnline())
@@ -527,10 +559,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             }
             else
             {
-                if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
-                iThreatContainer.addReference(hostilRef);
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatContainer.addReference(hostilRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -22,9 +22,11 @@
 #include "Common.h"
 #include "SharedDefines.h"
 #include "LinkedReference/Reference.h"
+#include "Dynamic/IndexedHeap.h"
 #include "UnitEvents.h"
 
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -47,6 +49,9 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatManager>
 {
+        friend class ThreatContainer;
+        friend struct ThreatHeapOrder;
+
     public:
         HostileReference(Unit* refUnit, ThreatManager* threatManager, float threat);
 
@@ -120,6 +125,27 @@ class HostileReference : public Reference<Unit, ThreatManager>
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        // position in the ThreatContainer holding the reference
+        std::list<HostileReference*>::iterator iListPosition;
+        size_t iHeapIndex;
+        uint32 iThreatSequence;                             // orders equal threat, earlier added first
+};
+
+//==============================================================
+// Order of the threat heap and the sorted list, equal threat keeps the order the references were added in
+
+struct ThreatHeapOrder
+{
+    static bool IsBefore(HostileReference const* a, HostileReference const* b)
+    {
+        if (a->getThreat() != b->getThreat())
+            return a->getThreat() > b->getThreat();
+
+        return a->iThreatSequence < b->iThreatSequence;
+    }
+
+    static size_t& HeapIndex(HostileReference* ref) { return ref->iHeapIndex; }
 };
 
 //==============================================================
@@ -131,8 +157,10 @@ class ThreatContainer
 
     public:
         typedef std::list<HostileReference*> StorageType;
+        typedef Trinity::IndexedHeap<HostileReference, ThreatHeapOrder> HeapType;
+        typedef UNORDERED_MAP<uint64, HostileReference*> ReferenceMap;
 
-        ThreatContainer(): iDirty(false) { }
+        ThreatContainer(): iDirty(false), iThreatSequence(0) { }
 
         ~ThreatContainer() { clearReferences(); }
 
@@ -153,31 +181,33 @@ class ThreatContainer
 
         HostileReference* getMostHated() const
         {
-            return iThreatList.empty() ? NULL : iThreatList.front();
+            return iThreatHeap.top();
         }
 
         HostileReference* getReferenceByTarget(Unit* victim) const;
 
-        StorageType const & getThreatList() const { return iThreatList; }
+        // sorted by threat, highest first
+        StorageType const & getThreatList() const { update(); return iThreatList; }
 
     private:
-        void remove(HostileReference* hostileRef)
-        {
-            iThreatList.remove(hostileRef);
-        }
+        void remove(HostileReference* hostileRef);
 
-        void addReference(HostileReference* hostileRef)
-        {
-            iThreatList.push_back(hostileRef);
-        }
+        void addReference(HostileReference* hostileRef);
+
+        // Restore the heap order after the threat of the reference changed
+        void updateThreat(HostileReference* hostileRef);
 
         void clearReferences();
 
         // Sort the list if necessary
-        void update();
-
-        StorageType iThreatList;
-        bool iDirty;
+        void update() const;
+
+        mutable StorageType iThreatList;                    // sorted lazily, for iteration
+        HeapType iThreatHeap;                               // max-heap by threat, for victim selection
+        mutable Trinity::IndexedHeapWalker<HostileReference, ThreatHeapOrder> iVictimWalker; // reused by selectNextVictim
+        ReferenceMap iReferences;                           // by target guid
+        mutable bool iDirty;                                // iThreatList is not sorted
+        uint32 iThreatSequence;
 };
 
 //=================================================
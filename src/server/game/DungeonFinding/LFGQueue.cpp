@@ -52,6 +52,87 @@ std::string ConcatenateGuids(LfgGuidList const& check)
     return o.str();
 }
 
+LfgCompatibilityKey::LfgCompatibilityKey(LfgGuidList const& check): size(0)
+{
+    memset(guids, 0, sizeof(guids));
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && size < MaxSize; ++it)
+        guids[size++] = *it;
+
+    // need the guids in order to avoid duplicates
+    std::sort(guids, guids + size);
+    size = uint8(std::unique(guids, guids + size) - guids);
+    for (uint8 i = size; i < MaxSize; ++i)
+        guids[i] = 0;
+}
+
+bool LfgCompatibilityKey::Contains(uint64 guid) const
+{
+    return std::binary_search(guids, guids + size, guid);
+}
+
+std::string LfgCompatibilityKey::ToString() const
+{
+    std::ostringstream o;
+    for (uint8 i = 0; i < size; ++i)
+    {
+        if (i)
+            o << '|';
+        o << guids[i];
+    }
+
+    return o.str();
+}
+
+/**
+   Bit (tanks | healers << 1 | dps << 2) is set when the roles can be assigned
+   using that many tanks, healers and dps without exceeding the needed amounts
+
+   @param[in]     roles Roles of the players of a queued player or group
+   @returns Mask of the feasible role counts, 0 if roles can not be assigned
+*/
+uint16 LfgQueueData::GetRolesMask(LfgRolesMap const& roles)
+{
+    uint16 mask = 1;                                       // nobody assigned yet
+    for (LfgRolesMap::const_iterator it = roles.begin(); it != roles.end(); ++it)
+    {
+        uint16 playerMask = 0;
+        if (it->second & PLAYER_ROLE_TANK)
+            playerMask |= 1 << 1;
+        if (it->second & PLAYER_ROLE_HEALER)
+            playerMask |= 1 << 2;
+        if (it->second & PLAYER_ROLE_DAMAGE)
+            playerMask |= 1 << 4;
+
+        mask = CombineRolesMasks(mask, playerMask);
+    }
+
+    return mask;
+}
+
+uint16 LfgQueueData::CombineRolesMasks(uint16 left, uint16 right)
+{
+    uint16 mask = 0;
+    for (uint8 i = 0; i < 16; ++i)
+    {
+        if (!(left & (1 << i)))
+            continue;
+
+        for (uint8 j = 0; j < 16; ++j)
+        {
+            if (!(right & (1 << j)))
+                continue;
+
+            uint8 tanks = (i & 1) + (j & 1);
+            uint8 healers = ((i >> 1) & 1) + ((j >> 1) & 1);
+            uint8 dps = (i >> 2) + (j >> 2);
+            if (tanks <= LFG_TANKS_NEEDED && healers <= LFG_HEALERS_NEEDED && dps <= LFG_DPS_NEEDED)
+                mask |= 1 << (tanks | healers << 1 | dps << 2);
+        }
+    }
+
+    return mask;
+}
+
 char const* GetCompatibleString(LfgCompatibility compatibles)
 {
     switch (compatibles)
@@ -99,15 +180,11 @@ void LFGQueue::RemoveFromQueue(uint64 guid)
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::ostringstream o;
-    o << guid;
-    std::string sguid = o.str();
-
     LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
         if (itr->first != guid)
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
+            if (itr->second.bestCompatible.Contains(guid))
             {
                 itr->second.bestCompatible.clear();
                 FindBestCompatibleInQueue(itr);
@@ -188,43 +265,60 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
+    LfgCompatibleGuidIndex::iterator itr = CompatibleGuidStore.find(guid);
+    if (itr == CompatibleGuidStore.end())
+        return;
+
+    LfgCompatibilityKeySet keys;
+    keys.swap(itr->second);
+    CompatibleGuidStore.erase(itr);
+
+    for (LfgCompatibilityKeySet::const_iterator it = keys.begin(); it != keys.end(); ++it)
     {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
+        CompatibleMapStore.erase(*it);
+
+        // the other guids of the key must not keep it either
+        for (uint8 i = 0; i < it->size; ++i)
+        {
+            if (it->guids[i] == guid)
+                continue;
+
+            LfgCompatibleGuidIndex::iterator itrOther = CompatibleGuidStore.find(it->guids[i]);
+            if (itrOther == CompatibleGuidStore.end())
+                continue;
+
+            itrOther->second.erase(*it);
+            if (itrOther->second.empty())
+                CompatibleGuidStore.erase(itrOther);
+        }
     }
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
+    LfgCompatibilityData& data = GetOrCreateCompatibilityData(key);
     data.compatibility = compatibles;
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    GetOrCreateCompatibilityData(key) = data;
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -233,13 +327,14 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData& LFGQueue::GetOrCreateCompatibilityData(LfgCompatibilityKey const& key)
 {
-    LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
-    if (itr != CompatibleMapStore.end())
-        return &(itr->second);
+    std::pair<LfgCompatibleContainer::iterator, bool> res = CompatibleMapStore.insert(std::make_pair(key, LfgCompatibilityData()));
+    if (res.second)
+        for (uint8 i = 0; i < key.size; ++i)
+            CompatibleGuidStore[key.guids[i]].insert(key);
 
-    return NULL;
+    return res.first->second;
 }
 
 uint8 LFGQueue::FindGroups()
@@ -274,17 +369,21 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    if (check.size() > LfgCompatibilityKey::MaxSize)
+        return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
+
+    LfgCompatibilityKey key(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
-    sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindNewGroup: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
+    if (sLog->ShouldLog(LOG_FILTER_LFG, LOG_LEVEL_DEBUG))
+        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindNewGroup: (%s): %s - all(%s)", key.ToString().c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
 
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
-        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", key.ToString().c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -312,7 +411,6 @@ LfgCompatibility LFGQueue::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -321,10 +419,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // Check for correct size
     if (check.size() > MAXGROUPSIZE || check.empty())
     {
-        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", ConcatenateGuids(check).c_str());
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
+    LfgCompatibilityKey key(check);
+    // Guids are only formatted for debug output
+    std::string strGuids = sLog->ShouldLog(LOG_FILTER_LFG, LOG_LEVEL_DEBUG) ? key.ToString() : std::string();
+
     // Check all-but-new compatiblitity
     if (check.size() > 2)
     {
@@ -335,8 +437,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            if (sLog->ShouldLog(LOG_FILTER_LFG, LOG_LEVEL_DEBUG))
+                sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -380,22 +483,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAXGROUPSIZE)
     {
         sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -423,19 +526,27 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", strGuids.c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
-        LfgRolesMap debugRoles = proposalRoles;
-        if (!LFGMgr::CheckGroupRoles(proposalRoles))
+        // Precomputed role masks reject most role mismatches without trying role permutations
+        uint16 rolesMask = 1;
+        for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && rolesMask; ++it)
+            rolesMask = LfgQueueData::CombineRolesMasks(rolesMask, QueueDataStore[*it].rolesMask);
+
+        LfgRolesMap debugRoles;
+        if (sLog->ShouldLog(LOG_FILTER_LFG, LOG_LEVEL_DEBUG))
+            debugRoles = proposalRoles;
+
+        if (!rolesMask || !LFGMgr::CheckGroupRoles(proposalRoles))
         {
             std::ostringstream o;
             for (LfgRolesMap::const_iterator it = debugRoles.begin(); it != debugRoles.end(); ++it)
                 o << ", " << it->first << ": " << sLFGMgr->GetRolesString(it->second);
 
             sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -455,7 +566,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         if (proposalDungeons.empty())
         {
             sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -476,9 +587,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
         data.roles = proposalRoles;
 
         for (LfgGuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -489,7 +600,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     if (!sLFGMgr->AllQueued(check))
     {
         sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -531,7 +642,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     sLFGMgr->AddProposal(proposal);
 
     sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -622,40 +733,56 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+            o << "(" << itr->first.ToString() << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
 
     return o.str();
 }
 
+uint32 LFGQueue::GetCompatibleCount() const
+{
+    return uint32(CompatibleMapStore.size());
+}
+
+uint32 LFGQueue::GetCompatibleIndexCount() const
+{
+    uint32 count = 0;
+    for (LfgCompatibleGuidIndex::const_iterator itr = CompatibleGuidStore.begin(); itr != CompatibleGuidStore.end(); ++itr)
+        count += uint32(itr->second.size());
+
+    return count;
+}
+
+LfgGuidList const& LFGQueue::GetCurrentQueue() const
+{
+    return currentQueueStore;
+}
+
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::FindBestCompatibleInQueue: " UI64FMTD, itrQueue->first);
-    std::ostringstream o;
-    o << itrQueue->first;
-    std::string sguid = o.str();
+    LfgCompatibleGuidIndex::iterator itrKeys = CompatibleGuidStore.find(itrQueue->first);
+    if (itrKeys == CompatibleGuidStore.end())
+        return;
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
-            UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    LfgCompatibilityKeySet const& keys = itrKeys->second;
+    for (LfgCompatibilityKeySet::const_iterator itr = keys.begin(); itr != keys.end(); ++itr)
+    {
+        LfgCompatibleContainer::const_iterator itrData = CompatibleMapStore.find(*itr);
+        if (itrData != CompatibleMapStore.end() && itrData->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
+            UpdateBestCompatibleInQueue(itrQueue, itrData->first, itrData->second.roles);
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size <= queueData.bestCompatible.size)
         return;
 
-    sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::UpdateBestCompatibleInQueue: Changed (%s) to (%s) as best compatible group for " UI64FMTD,
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first);
+    if (sLog->ShouldLog(LOG_FILTER_LFG, LOG_LEVEL_DEBUG))
+        sLog->outDebug(LOG_FILTER_LFG, "LFGQueue::UpdateBestCompatibleInQueue: Changed (%s) to (%s) as best compatible group for " UI64FMTD,
+            queueData.bestCompatible.ToString().c_str(), key.ToString().c_str(), itrQueue->first);
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
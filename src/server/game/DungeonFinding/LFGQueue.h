@@ -19,6 +19,7 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include "Dynamic/UnorderedSet.h"
 
 enum LfgCompatibility
 {
@@ -34,6 +35,40 @@ enum LfgCompatibility
     LFG_COMPATIBLES_MATCH                                  // Must be the last one
 };
 
+/// Sorted guids of the queued players or groups in a compatibility check, used as fixed size key
+struct LfgCompatibilityKey
+{
+    static uint8 const MaxSize = LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED;
+
+    LfgCompatibilityKey(): size(0) { memset(guids, 0, sizeof(guids)); }
+    explicit LfgCompatibilityKey(LfgGuidList const& check);
+
+    bool Contains(uint64 guid) const;
+    bool empty() const { return !size; }
+    void clear() { *this = LfgCompatibilityKey(); }
+    std::string ToString() const;
+
+    bool operator==(LfgCompatibilityKey const& right) const
+    {
+        return size == right.size && !memcmp(guids, right.guids, sizeof(guids));
+    }
+
+    uint64 guids[MaxSize];
+    uint8 size;
+};
+
+struct LfgCompatibilityKeyHash
+{
+    size_t operator()(LfgCompatibilityKey const& key) const
+    {
+        // FNV-1a over the guids
+        uint64 hash = UI64LIT(0xCBF29CE484222325);
+        for (uint8 i = 0; i < key.size; ++i)
+            hash = (hash ^ key.guids[i]) * UI64LIT(0x100000001B3);
+        return size_t(hash ^ (hash >> 32));
+    }
+};
+
 struct LfgCompatibilityData
 {
     LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
@@ -49,21 +84,25 @@ struct LfgCompatibilityData
 struct LfgQueueData
 {
     LfgQueueData(): joinTime(time_t(time(NULL))), tanks(LFG_TANKS_NEEDED),
-        healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
+        healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), rolesMask(0)
         { }
 
     LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles):
         joinTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles)
+        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles), rolesMask(GetRolesMask(_roles))
         { }
 
+    static uint16 GetRolesMask(LfgRolesMap const& roles);
+    static uint16 CombineRolesMasks(uint16 left, uint16 right);
+
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
     uint8 tanks;                                           ///< Tanks needed
     uint8 healers;                                         ///< Healers needed
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    uint16 rolesMask;                                      ///< Feasible (tanks, healers, dps) counts of the roles, see GetRolesMask
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
 };
 
 struct LfgWaitTime
@@ -74,7 +113,9 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef UNORDERED_MAP<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> LfgCompatibleContainer;
+typedef UNORDERED_SET<LfgCompatibilityKey, LfgCompatibilityKeyHash> LfgCompatibilityKeySet;
+typedef UNORDERED_MAP<uint64, LfgCompatibilityKeySet> LfgCompatibleGuidIndex;
 typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -106,6 +147,9 @@ class LFGQueue
         // Just for debugging purposes
         std::string DumpQueueInfo() const;
         std::string DumpCompatibleInfo(bool full = false) const;
+        uint32 GetCompatibleCount() const;
+        uint32 GetCompatibleIndexCount() const;
+        LfgGuidList const& GetCurrentQueue() const;
 
     private:
         void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
@@ -116,14 +160,14 @@ class LFGQueue
         void RemoveFromNewQueue(uint64 guid);
         void RemoveFromCurrentQueue(uint64 guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(uint64 guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData& GetOrCreateCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(LfgGuidList& check, LfgGuidList& all);
         LfgCompatibility CheckCompatibility(LfgGuidList check);
@@ -131,6 +175,7 @@ class LFGQueue
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        LfgCompatibleGuidIndex CompatibleGuidStore;        ///< Keys of CompatibleMapStore containing a guid
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -17,7 +17,6 @@
  */
 
 #include "stdafx.hpp"
-#include <mutex>
 #include "Common.h"
 #include "SharedDefines.h"
 #include "WorldPacket.h"
@@ -39,7 +38,6 @@
 #include "TargetedMovementGenerator.h"
 #include "WaypointMovementGenerator.h"
 #include "VMapFactory.h"
-#include "vmap_mutex.hpp"
 #include "CellImpl.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
@@ -90,6 +88,16 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
 
 WorldObject::~WorldObject()
 {
+    // pending values updates are queued in the map, ~Object can only reach the ObjectAccessor queue
+    if (m_objectUpdated)
+    {
+        sLog->outFatal(LOG_FILTER_GENERAL, "WorldObject::~WorldObject - guid=" UI64FMTD", typeid=%d, entry=%u deleted but still in update list!!", GetGUID(), GetTypeId(), GetEntry());
+        ASSERT(false);
+        if (m_currMap)
+            RemoveFromObjectUpdate();
+        m_objectUpdated = false;
+    }
+
     // this may happen because there are many !create/delete
     if (IsWorldObject() && m_currMap)
     {
@@ -280,8 +288,21 @@ void Object::SendUpdateToPlayer(Player* player)
     player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache* cache) const
 {
+    uint32 visibility = 0;
+    if (cache)
+    {
+        visibility = GetUpdateVisibilityClass(target);
+        // an empty block marks a class whose values have to be built per observer
+        ValuesUpdateBlockCache::const_iterator itr = cache->find(visibility);
+        if (itr != cache->end() && !itr->second.empty())
+        {
+            data->AddUpdateBlock(itr->second);
+            return;
+        }
+    }
+
     ByteBuffer buf(500);
 
     buf << (uint8) UPDATETYPE_VALUES;
@@ -294,6 +315,13 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     _BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
 
     data->AddUpdateBlock(buf);
+
+    if (cache)
+    {
+        ByteBuffer& cached = (*cache)[visibility];
+        if (cached.empty() && IsValuesUpdateShareable(updateMask))
+            cached = buf;
+    }
 }
 
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
@@ -765,7 +793,7 @@ void Object::ClearUpdateMask(bool remove)
     if (m_objectUpdated)
     {
         if (remove)
-            sObjectAccessor->RemoveUpdateObject(this);
+            RemoveFromObjectUpdate();
         m_objectUpdated = false;
     }
 }
@@ -775,7 +803,26 @@ bool Object::is_object_updated() const
     return m_objectUpdated;
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::AddToObjectUpdateIfNeeded()
+{
+    if (m_inWorld && !m_objectUpdated)
+    {
+        AddToObjectUpdate();
+        m_objectUpdated = true;
+    }
+}
+
+void Object::AddToObjectUpdate()
+{
+    sObjectAccessor->AddUpdateObject(this);
+}
+
+void Object::RemoveFromObjectUpdate()
+{
+    sObjectAccessor->RemoveUpdateObject(this);
+}
+
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -786,7 +833,7 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, cache);
 }
 
 void Object::GetUpdateFieldData(Player const* target, uint32*& flags, bool& isOwner, bool& isItemOwner, bool& hasSpecialInfo, bool& isPartyMember) const
@@ -849,6 +896,43 @@ bool Object::IsUpdateFieldVisible(uint32 flags, bool isSelf, bool isOwner, bool
     return false;
 }
 
+uint32 Object::GetUpdateVisibilityClass(Player const* target) const
+{
+    uint32* flags = NULL;
+    bool isOwner = false;
+    bool isItemOwner = false;
+    bool hasSpecialInfo = false;
+    bool isPartyMember = false;
+
+    GetUpdateFieldData(target, flags, isOwner, isItemOwner, hasSpecialInfo, isPartyMember);
+
+    // everything _SetUpdateBits and the observer independent part of _BuildValuesUpdate depend on
+    return (target == this ? 0x01 : 0) | (isOwner ? 0x02 : 0) | (isItemOwner ? 0x04 : 0) | (hasSpecialInfo ? 0x08 : 0) |
+        (isPartyMember ? 0x10 : 0) | (target->isGameMaster() ? 0x20 : 0);
+}
+
+bool Object::IsValuesUpdateShareable(UpdateMask const& updateMask) const
+{
+    // fields _BuildValuesUpdate rewrites per observer (npc flags, tapping, loot, raid faction, quest sparkles...)
+    static uint16 const unitIndexes[] = { UNIT_NPC_FLAGS, UNIT_FIELD_AURASTATE, UNIT_DYNAMIC_FLAGS, UNIT_FIELD_BYTES_2, UNIT_FIELD_FACTIONTEMPLATE };
+    static uint16 const gameObjectIndexes[] = { GAMEOBJECT_DYNAMIC, GAMEOBJECT_FLAGS };
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        for (uint8 i = 0; i < sizeof(unitIndexes) / sizeof(unitIndexes[0]); ++i)
+            if (updateMask.GetBit(unitIndexes[i]))
+                return false;
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        for (uint8 i = 0; i < sizeof(gameObjectIndexes) / sizeof(gameObjectIndexes[0]); ++i)
+            if (updateMask.GetBit(gameObjectIndexes[i]))
+                return false;
+    }
+
+    return true;
+}
+
 void Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count)
 {
     if (data.empty())
@@ -909,11 +993,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
         m_int32Values[index] = value;
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -926,11 +1006,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
         m_uint32Values[index] = value;
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -952,11 +1028,7 @@ void Object::SetUInt64Value(uint16 index, uint64 value)
         _changedFields[index] = true;
         _changedFields[index + 1] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -970,11 +1042,7 @@ bool Object::AddUInt64Value(uint16 index, uint64 value)
         _changedFields[index] = true;
         _changedFields[index + 1] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -992,11 +1060,7 @@ bool Object::RemoveUInt64Value(uint16 index, uint64 value)
         _changedFields[index] = true;
         _changedFields[index + 1] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -1013,11 +1077,7 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1037,11 +1097,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1061,11 +1117,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1128,11 +1180,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
         m_uint32Values[index] = newval;
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1149,11 +1197,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
         m_uint32Values[index] = newval;
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1172,11 +1216,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1195,11 +1235,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
         _changedFields[index] = true;
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1291,7 +1327,8 @@ void MovementInfo::OutDebug()
 WorldObject::WorldObject(bool isWorldObject): WorldLocation(),
 m_name(""), m_isActive(false), m_isWorldObject(isWorldObject), m_zoneScript(NULL),
 m_transport(NULL), m_currMap(NULL), m_InstanceId(0),
-m_phaseMask(PHASEMASK_NORMAL), m_notifyflags(0), m_executed_notifies(0)
+m_phaseMask(PHASEMASK_NORMAL), m_notifyflags(0), m_executed_notifies(0),
+m_areaCacheKey(AREA_CACHE_INVALID_KEY), m_cachedZoneId(0), m_cachedAreaId(0), m_cachedAreaFlag(0), m_cachedOutdoors(true)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
     m_serverSideVisibilityDetect.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE);
@@ -1361,19 +1398,46 @@ void WorldObject::_Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask)
     m_phaseMask = phaseMask;
 }
 
+void WorldObject::UpdateAreaCache() const
+{
+    uint64 key = Map::GetAreaCacheKey(m_positionX, m_positionY, m_positionZ);
+    if (key == m_areaCacheKey)
+        return;
+
+    m_cachedAreaFlag = GetBaseMap()->GetAreaFlag(m_positionX, m_positionY, m_positionZ, &m_cachedOutdoors);
+    Map::GetZoneAndAreaIdByAreaFlag(m_cachedZoneId, m_cachedAreaId, m_cachedAreaFlag, GetMapId());
+    m_areaCacheKey = key;
+}
+
 uint32 WorldObject::GetZoneId() const
 {
-    return GetBaseMap()->GetZoneId(m_positionX, m_positionY, m_positionZ);
+    UpdateAreaCache();
+    return m_cachedZoneId;
 }
 
 uint32 WorldObject::GetAreaId() const
 {
-    return GetBaseMap()->GetAreaId(m_positionX, m_positionY, m_positionZ);
+    UpdateAreaCache();
+    return m_cachedAreaId;
 }
 
 void WorldObject::GetZoneAndAreaId(uint32& zoneid, uint32& areaid) const
 {
-    GetBaseMap()->GetZoneAndAreaId(zoneid, areaid, m_positionX, m_positionY, m_positionZ);
+    UpdateAreaCache();
+    zoneid = m_cachedZoneId;
+    areaid = m_cachedAreaId;
+}
+
+uint16 WorldObject::GetAreaFlag() const
+{
+    UpdateAreaCache();
+    return m_cachedAreaFlag;
+}
+
+bool WorldObject::IsOutdoors() const
+{
+    UpdateAreaCache();
+    return m_cachedOutdoors;
 }
 
 InstanceScript* WorldObject::GetInstanceScript()
@@ -1441,7 +1505,6 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz) const
     /*float x, y, z;
     GetPosition(x, y, z);
     VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
-    std::lock_guard<vmap_mutex_type> l(vmap_mutex());
     return vMapManager->isInLineOfSight(GetMapId(), x, y, z+2.0f, ox, oy, oz+2.0f);*/
     if (IsInWorld())
         return GetMap()->isInLineOfSight(GetPositionX(), GetPositionY(), GetPositionZ()+2.f, ox, oy, oz+2.f, GetPhaseMask());
@@ -1984,11 +2047,7 @@ void WorldObject::SendPlaySound(uint32 Sound, bool OnlySelf)
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
     _changedFields[i] = true;
-    if (m_inWorld && !m_objectUpdated)
-    {
-        sObjectAccessor->AddUpdateObject(this);
-        m_objectUpdated = true;
-    }
+    AddToObjectUpdateIfNeeded();
 }
 
 namespace Trinity
@@ -2218,6 +2277,7 @@ void WorldObject::SetMap(Map* map)
     m_currMap = map;
     m_mapId = map->GetId();
     m_InstanceId = map->GetInstanceId();
+    InvalidateAreaCache();
     if (IsWorldObject())
         m_currMap->AddWorldObject(this);
 }
@@ -2229,6 +2289,7 @@ void WorldObject::ResetMap()
     if (IsWorldObject())
         m_currMap->RemoveWorldObject(this);
     m_currMap = NULL;
+    InvalidateAreaCache();
     //maybe not for corpse
     //m_mapId = 0;
     //m_InstanceId = 0;
@@ -2695,10 +2756,61 @@ void WorldObject::GetNearPoint(WorldObject const* /*searcher*/, float &x, float
     */
 }
 
+// the height from above (ground) or from z (floor) closest to z, with the .map height already sampled
+static float SelectGroundOrFloor(Map const* map, uint32 phaseMask, float gridHeight, float x, float y, float z)
+{
+    float ground = map->GetHeightFromGrid(phaseMask, gridHeight, x, y, MAX_HEIGHT, true);
+    float floor = map->GetHeightFromGrid(phaseMask, gridHeight, x, y, z, true);
+    return fabs(ground - z) <= fabs(floor - z) ? ground : floor;
+}
+
+// the ground or floor height closest to z, the .map height is sampled once
+static float GetGroundOrFloor(Map const* map, uint32 phaseMask, float x, float y, float z)
+{
+    float gridHeight;
+    map->GetGridHeights(&x, &y, &gridHeight, 1);
+    return SelectGroundOrFloor(map, phaseMask, gridHeight, x, y, z);
+}
+
+// Relocates pos to dest, stepping back towards pos while the z change is too big.
+// The .map heights of all steps are sampled together.
+static void RelocateWithReachableZ(WorldObject const* obj, Position& pos, float destx, float desty, float destz, float step, float angle)
+{
+    uint8 const steps = 9;                                  // steps of dist / 10 checked before giving up
+
+    // do not allow too big z changes
+    if (fabs(pos.m_positionZ - destz) <= 6)
+    {
+        pos.Relocate(destx, desty, destz);
+        return;
+    }
+
+    float xs[steps], ys[steps], gridHeights[steps];
+    for (uint8 j = 0; j < steps; ++j)
+    {
+        xs[j] = (j ? xs[j - 1] : destx) - step * std::cos(angle);
+        ys[j] = (j ? ys[j - 1] : desty) - step * std::sin(angle);
+    }
+
+    Map const* map = obj->GetMap();
+    map->GetGridHeights(xs, ys, gridHeights, steps);
+
+    for (uint8 j = 0; j < steps; ++j)
+    {
+        destz = SelectGroundOrFloor(map, obj->GetPhaseMask(), gridHeights[j], xs[j], ys[j], pos.m_positionZ);
+        // we have correct destz now
+        if (fabs(pos.m_positionZ - destz) <= 6)
+        {
+            pos.Relocate(xs[j], ys[j], destz);
+            return;
+        }
+    }
+}
+
 void WorldObject::MovePosition(Position &pos, float dist, float angle)
 {
     angle += m_orientation;
-    float destx, desty, destz, ground, floor;
+    float destx, desty, destz;
     destx = pos.m_positionX + dist * std::cos(angle);
     desty = pos.m_positionY + dist * std::sin(angle);
 
@@ -2709,30 +2821,9 @@ void WorldObject::MovePosition(Position &pos, float dist, float angle)
         return;
     }
 
-    ground = GetMap()->GetHeight(GetPhaseMask(), destx, desty, MAX_HEIGHT, true);
-    floor = GetMap()->GetHeight(GetPhaseMask(), destx, desty, pos.m_positionZ, true);
-    destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
+    destz = GetGroundOrFloor(GetMap(), GetPhaseMask(), destx, desty, pos.m_positionZ);
 
-    float step = dist/10.0f;
-
-    for (uint8 j = 0; j < 10; ++j)
-    {
-        // do not allow too big z changes
-        if (fabs(pos.m_positionZ - destz) > 6)
-        {
-            destx -= step * std::cos(angle);
-            desty -= step * std::sin(angle);
-            ground = GetMap()->GetHeight(GetPhaseMask(), destx, desty, MAX_HEIGHT, true);
-            floor = GetMap()->GetHeight(GetPhaseMask(), destx, desty, pos.m_positionZ, true);
-            destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
-        }
-        // we have correct destz now
-        else
-        {
-            pos.Relocate(destx, desty, destz);
-            break;
-        }
-    }
+    RelocateWithReachableZ(this, pos, destx, desty, destz, dist / 10.0f, angle);
 
     Trinity::NormalizeMapCoord(pos.m_positionX);
     Trinity::NormalizeMapCoord(pos.m_positionY);
@@ -2743,7 +2834,7 @@ void WorldObject::MovePosition(Position &pos, float dist, float angle)
 void WorldObject::MovePositionToFirstCollision(Position &pos, float dist, float angle)
 {
     angle += m_orientation;
-    float destx, desty, destz, ground, floor;
+    float destx, desty, destz;
     pos.m_positionZ += 2.0f;
     destx = pos.m_positionX + dist * std::cos(angle);
     desty = pos.m_positionY + dist * std::sin(angle);
@@ -2755,18 +2846,10 @@ void WorldObject::MovePositionToFirstCollision(Position &pos, float dist, float
         return;
     }
 
-    ground = GetMap()->GetHeight(GetPhaseMask(), destx, desty, MAX_HEIGHT, true);
-    floor = GetMap()->GetHeight(GetPhaseMask(), destx, desty, pos.m_positionZ, true);
-    destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
+    destz = GetGroundOrFloor(GetMap(), GetPhaseMask(), destx, desty, pos.m_positionZ);
 
-    bool col;
-    {
-        auto &m = *VMAP::VMapFactory::createOrGetVMapManager();
-        std::lock_guard<vmap_mutex_type> l(vmap_mutex());
-        col = m.getObjectHitPos(GetMapId(), pos.m_positionX, pos.m_positionY,
-                    pos.m_positionZ + 0.5f, destx, desty, destz + 0.5f, destx, desty,
-                    destz, -0.5f);
-    }
+    bool col = VMAP::VMapFactory::createOrGetVMapManager()->getObjectHitPos(GetMapId(), pos.m_positionX, pos.m_positionY,
+        pos.m_positionZ + 0.5f, destx, desty, destz + 0.5f, destx, desty, destz, -0.5f);
 
     // collision occured
     if (col)
@@ -2788,26 +2871,7 @@ void WorldObject::MovePositionToFirstCollision(Position &pos, float dist, float
         dist = sqrt((pos.m_positionX - destx)*(pos.m_positionX - destx) + (pos.m_positionY - desty)*(pos.m_positionY - desty));
     }
 
-    float step = dist/10.0f;
-
-    for (uint8 j = 0; j < 10; ++j)
-    {
-        // do not allow too big z changes
-        if (fabs(pos.m_positionZ - destz) > 6)
-        {
-            destx -= step * std::cos(angle);
-            desty -= step * std::sin(angle);
-            ground = GetMap()->GetHeight(GetPhaseMask(), destx, desty, MAX_HEIGHT, true);
-            floor = GetMap()->GetHeight(GetPhaseMask(), destx, desty, pos.m_positionZ, true);
-            destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
-        }
-        // we have correct destz now
-        else
-        {
-            pos.Relocate(destx, desty, destz);
-            break;
-        }
-    }
+    RelocateWithReachableZ(this, pos, destx, desty, destz, dist / 10.0f, angle);
 
     Trinity::NormalizeMapCoord(pos.m_positionX);
     Trinity::NormalizeMapCoord(pos.m_positionY);
@@ -2883,6 +2947,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     std::set<uint64> plr_list;
+    ValuesUpdateBlockCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
     void Visit(PlayerMapType &m)
     {
@@ -2940,7 +3005,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesCache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -2962,6 +3027,16 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     ClearUpdateMask(false);
 }
 
+void WorldObject::AddToObjectUpdate()
+{
+    GetMap()->AddUpdateObject(this);
+}
+
+void WorldObject::RemoveFromObjectUpdate()
+{
+    GetMap()->RemoveUpdateObject(this);
+}
+
 uint64 WorldObject::GetTransGUID() const
 {
     if (GetTransport())
@@ -117,6 +117,8 @@ class Unit;
 class Transport;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
+// values update blocks built once per observer visibility class while one object's changes are sent
+typedef std::map<uint32, ByteBuffer> ValuesUpdateBlockCache;
 
 class Object
 {
@@ -144,7 +146,7 @@ class Object
         virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void SendUpdateToPlayer(Player* player);
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache* cache = NULL) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint32 flags = 0) const;
 
@@ -295,11 +297,13 @@ class Object
         uint16 GetValuesCount() const { return m_valuesCount; }
 
         bool is_object_updated() const;
+        // drops a pending values update without clearing the changed fields
+        virtual void RemoveFromObjectUpdate();
 
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateBlockCache* cache = NULL) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -324,6 +328,9 @@ class Object
         Object();
 
         void _InitValues();
+        void AddToObjectUpdateIfNeeded();
+        // objects with a map queue their values updates there, the rest go to ObjectAccessor
+        virtual void AddToObjectUpdate();
         void _Create(uint32 guidlow, uint32 entry, HighGuid guidhigh);
         std::string _ConcatFields(uint16 startIndex, uint16 size) const;
         void _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
@@ -331,6 +338,8 @@ class Object
         void GetUpdateFieldData(Player const* target, uint32*& flags, bool& isOwner, bool& isItemOwner, bool& hasSpecialInfo, bool& isPartyMember) const;
 
         bool IsUpdateFieldVisible(uint32 flags, bool isSelf, bool isOwner, bool isItemOwner, bool isPartyMember) const;
+        uint32 GetUpdateVisibilityClass(Player const* target) const;
+        bool IsValuesUpdateShareable(UpdateMask const& updateMask) const;
 
         void _SetUpdateBits(UpdateMask* updateMask, Player* target) const;
         void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
@@ -649,9 +658,12 @@ class WorldObject : public Object, public WorldLocation
         bool InSamePhase(WorldObject const* obj) const { return InSamePhase(obj->GetPhaseMask()); }
         bool InSamePhase(uint32 phasemask) const { return (GetPhaseMask() & phasemask); }
 
+        // answered from a cache refreshed when the object leaves its area cache cell or map
         uint32 GetZoneId() const;
         uint32 GetAreaId() const;
         void GetZoneAndAreaId(uint32& zoneid, uint32& areaid) const;
+        uint16 GetAreaFlag() const;
+        bool IsOutdoors() const;
 
         InstanceScript* GetInstanceScript();
 
@@ -808,6 +820,8 @@ class WorldObject : public Object, public WorldLocation
         void DestroyForNearbyPlayers();
         virtual void UpdateObjectVisibility(bool forced = true);
         void BuildUpdate(UpdateDataMapType&);
+        void AddToObjectUpdate();
+        void RemoveFromObjectUpdate();
 
         //relocation and visibility system functions
         void AddToNotify(uint16 f) { m_notifyflags |= f;}
@@ -879,6 +893,15 @@ class WorldObject : public Object, public WorldLocation
         uint16 m_notifyflags;
         uint16 m_executed_notifies;
 
+        void UpdateAreaCache() const;
+        void InvalidateAreaCache() { m_areaCacheKey = AREA_CACHE_INVALID_KEY; }
+
+        mutable uint64 m_areaCacheKey;                      // Map::GetAreaCacheKey of the cached lookup
+        mutable uint32 m_cachedZoneId;
+        mutable uint32 m_cachedAreaId;
+        mutable uint16 m_cachedAreaFlag;
+        mutable bool m_cachedOutdoors;
+
         virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D) const;
 
         bool CanNeverSee(WorldObject const* obj) const { return GetMap() != obj->GetMap() || !InSamePhase(obj); }
@@ -78,6 +78,7 @@
 #include "Vehicle.h"
 #include "Weather.h"
 #include "WeatherMgr.h"
+#include "WhoListIndex.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -6953,10 +6954,9 @@ void Player::CheckAreaExploreAndOutdoor()
         wmo_id_ = new_wmo_id;
         GetMap()->player_zone_changed(*this);
     }
-    bool isOutdoor;
-    uint16 areaFlag = GetBaseMap()->GetAreaFlag(GetPositionX(), GetPositionY(), GetPositionZ(), &isOutdoor);
+    uint16 areaFlag = GetAreaFlag();
 
-    if (sWorld->getBoolConfig(CONFIG_VMAP_INDOOR_CHECK) && !isOutdoor)
+    if (sWorld->getBoolConfig(CONFIG_VMAP_INDOOR_CHECK) && !IsOutdoors())
         RemoveAurasWithAttribute(SPELL_ATTR0_OUTDOORS_ONLY);
 
     if (areaFlag == 0xffff)
@@ -7466,6 +7466,12 @@ void Player::ModifyArenaPoints(int32 value, SQLTransaction* trans /*=NULL*/)
     }
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+    sWhoListIndex->UpdateGuild(GetGUIDLow(), GuildId);
+}
+
 uint32 Player::GetGuildIdFromDB(uint64 guid)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_MEMBER);
@@ -7601,6 +7607,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
         sBattlefieldMgr->HandlePlayerEnterZone(this, newZone);
         if (Guild* guild = GetGuild())
             guild->UpdateMemberData(this, GUILD_MEMBER_DATA_ZONEID, newZone);
+        sWhoListIndex->UpdateZone(GetGUIDLow(), newZone);
     }
 
     // group update
@@ -18931,7 +18938,7 @@ void Player::SaveToDB(bool create /*=false*/)
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
-    sLog->outDebug(LOG_FILTER_UNITS, "The value of player %s at save: ", m_name.c_str());
+    TC_LOG_DEBUG(LOG_FILTER_UNITS, "The value of player %s at save: ", m_name.c_str());
     outDebugValues();
 
     PreparedStatement* stmt = NULL;
@@ -19155,6 +19162,10 @@ void Player::SaveToDB(bool create /*=false*/)
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
+    // the diffed tables trust the rows of this save once the database thread reports the commit
+    m_saveResult = SQLTransactionResult(new std::atomic<uint8>(SQL_TRANSACTION_PENDING));
+    trans->SetResult(m_saveResult);
+
     trans->Append(stmt);
 
     if (m_mailsUpdated)                                     //save mails only when needed
@@ -19185,6 +19196,11 @@ void Player::SaveToDB(bool create /*=false*/)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    ++m_saveStats.Saves;
+    m_saveStats.Statements += trans->GetSize();
+    TC_LOG_DEBUG(LOG_FILTER_PLAYER, "Player::SaveToDB: %s (GUID: %u) save %u queued " UI64FMTD " statements so far, saved " UI64FMTD " statements and " UI64FMTD " bytes",
+        GetName().c_str(), GetGUIDLow(), m_saveStats.Saves, m_saveStats.Statements, m_saveStats.SkippedStatements, m_saveStats.SkippedBytes);
+
     CharacterDatabase.CommitTransaction(trans);
 
     // save pet (hunter pet level and experience and all type pets health/mana).
@@ -19257,10 +19273,19 @@ void Player::_SaveActions(SQLTransaction& trans)
 
 void Player::_SaveAuras(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
+    m_savedAuras.Begin(m_saveResult);
 
+    PreparedStatement* stmt = NULL;
+
+    // nothing known about the stored rows, rewrite them all
+    if (!m_savedAuras.IsValid())
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUIDLow());
+        trans->Append(stmt);
+    }
+
+    TransactionBatch batch(trans, CHAR_REP_AURA_BATCH, CHARACTER_BATCH_ROWS);
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -19290,7 +19315,7 @@ void Player::_SaveAuras(SQLTransaction& trans)
         }
 
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_AURA);
         stmt->setUInt32(index++, GetGUIDLow());
         stmt->setUInt64(index++, itr->second->GetCasterGUID());
         stmt->setUInt64(index++, itr->second->GetCastItemGUID());
@@ -19307,10 +19332,153 @@ void Player::_SaveAuras(SQLTransaction& trans)
         stmt->setInt32(index++, itr->second->GetMaxDuration());
         stmt->setInt32(index++, itr->second->GetDuration());
         stmt->setUInt8(index, itr->second->GetCharges());
+
+        // auras with a timer change on every save, the others only when their stacks or amounts do
+        PlayerAuraSaveKey key(aura->GetCasterGUID(), aura->GetCastItemGUID(), aura->GetId(), effMask);
+        if (!_IsSaveRowChanged(m_savedAuras, key, stmt))
+        {
+            delete stmt;
+            continue;
+        }
+
+        batch.Append(stmt);
+    }
+
+    batch.Flush();
+    UpdateSaveStats(batch);
+
+    PlayerSavedRows<PlayerAuraSaveKey>::KeyList removed;
+    m_savedAuras.Finish(removed);
+    for (PlayerSavedRows<PlayerAuraSaveKey>::KeyList::const_iterator itr = removed.begin(); itr != removed.end(); ++itr)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_BY_KEY);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt64(1, itr->CasterGuid);
+        stmt->setUInt64(2, itr->ItemGuid);
+        stmt->setUInt32(3, itr->SpellId);
+        stmt->setUInt8(4, itr->EffectMask);
         trans->Append(stmt);
     }
 }
 
+template<class Key>
+void PlayerSavedRows<Key>::Begin(SQLTransactionResult const& result)
+{
+    bool stored = _lastSave.null() || _lastSave->load() == SQL_TRANSACTION_COMMITTED;
+
+    // the delete of all rows may not have happened
+    if (_rewriting && !stored)
+        _valid = false;
+
+    if (!_valid)
+    {
+        _rows.clear();
+        _removed.clear();
+    }
+    else if (stored)
+        _removed.clear();
+
+    _rewriting = !_valid;
+    _lastSaveStored = stored;
+    _lastSave = result;
+}
+
+template<class Key>
+bool PlayerSavedRows<Key>::Update(Key const& key, PreparedStatement const* stmt)
+{
+    Row& row = _rows[key];
+    std::vector<PreparedStatementData> const& parameters = stmt->GetParameters();
+    bool stored = _valid && row.written && (row.written != _save || _lastSaveStored) &&
+        row.parameters.size() == parameters.size() && std::equal(row.parameters.begin(), row.parameters.end(), parameters.begin());
+
+    row.seen = _save + 1;
+    if (stored)
+        return false;
+
+    row.parameters = parameters;
+    row.written = _save + 1;
+    return true;
+}
+
+template<class Key>
+void PlayerSavedRows<Key>::Finish(KeyList& removed)
+{
+    ++_save;
+    for (typename RowMap::iterator itr = _rows.begin(); itr != _rows.end();)
+    {
+        if (itr->second.seen == _save)
+        {
+            ++itr;
+            continue;
+        }
+
+        if (_valid)
+            removed.push_back(itr->first);
+        _rows.erase(itr++);
+    }
+
+    // deleted again, unless this save wrote the row
+    for (typename KeyList::const_iterator itr = _removed.begin(); itr != _removed.end(); ++itr)
+        if (_rows.find(*itr) == _rows.end())
+            removed.push_back(*itr);
+
+    _removed = removed;
+    _valid = true;
+}
+
+// Bytes of the values bound to a statement
+static size_t GetSaveRowSize(std::vector<PreparedStatementData> const& parameters)
+{
+    size_t size = 0;
+    for (std::vector<PreparedStatementData>::const_iterator itr = parameters.begin(); itr != parameters.end(); ++itr)
+    {
+        switch (itr->type)
+        {
+            case TYPE_BOOL:
+            case TYPE_UI8:
+            case TYPE_I8:
+                size += 1;
+                break;
+            case TYPE_UI16:
+            case TYPE_I16:
+                size += 2;
+                break;
+            case TYPE_UI32:
+            case TYPE_I32:
+            case TYPE_FLOAT:
+                size += 4;
+                break;
+            case TYPE_UI64:
+            case TYPE_I64:
+            case TYPE_DOUBLE:
+                size += 8;
+                break;
+            case TYPE_STRING:
+                size += itr->str.size();
+                break;
+            case TYPE_NULL:
+                break;
+        }
+    }
+
+    return size;
+}
+
+/// Rows of the diffed tables are only written when they are not stored already.
+/// Returns false for these, the caller frees the unused statement.
+template<class Key>
+bool Player::_IsSaveRowChanged(PlayerSavedRows<Key>& saved, Key const& key, PreparedStatement const* stmt)
+{
+    ++m_saveStats.Rows;
+    if (saved.Update(key, stmt))
+        return true;
+
+    ++m_saveStats.SkippedRows;
+    ++m_saveStats.SkippedStatements;
+    m_saveStats.SkippedBytes += GetSaveRowSize(stmt->GetParameters());
+    return false;
+}
+
 void Player::_SaveInventory(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
@@ -19365,6 +19533,8 @@ void Player::_SaveInventory(SQLTransaction& trans)
         return;
 
     uint32 lowGuid = GetGUIDLow();
+    // inventory rows only, item_instance rows are written by Item::SaveToDB
+    TransactionBatch batch(trans, CHAR_REP_INVENTORY_ITEM_BATCH, CHARACTER_BATCH_ROWS);
     for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
     {
         Item* item = m_itemUpdateQueue[i];
@@ -19416,7 +19586,7 @@ void Player::_SaveInventory(SQLTransaction& trans)
                 stmt->setUInt32(1, bag_guid);
                 stmt->setUInt8 (2, item->GetSlot());
                 stmt->setUInt32(3, item->GetGUIDLow());
-                trans->Append(stmt);
+                batch.Append(stmt);
                 break;
             case ITEM_REMOVED:
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INVENTORY_BY_ITEM);
@@ -19429,6 +19599,9 @@ void Player::_SaveInventory(SQLTransaction& trans)
         item->SaveToDB(trans);                                   // item have unchanged inventory record and can be save standalone
     }
     m_itemUpdateQueue.clear();
+
+    batch.Flush();
+    UpdateSaveStats(batch);
 }
 
 void Player::_SaveMail(SQLTransaction& trans)
@@ -19692,6 +19865,7 @@ void Player::_SaveMonthlyQuestStatus(SQLTransaction& trans)
 void Player::_SaveSkills(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
+    TransactionBatch batch(trans, CHAR_REP_CHAR_SKILLS_BATCH, CHARACTER_BATCH_ROWS);
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
     {
@@ -19713,36 +19887,22 @@ void Player::_SaveSkills(SQLTransaction& trans)
         }
 
         uint32 valueData = GetUInt32Value(PLAYER_SKILL_VALUE_INDEX(itr->second.pos));
-        uint16 value = SKILL_VALUE(valueData);
-        uint16 max = SKILL_MAX(valueData);
 
-        switch (itr->second.uState)
-        {
-            case SKILL_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SKILLS);
-                stmt->setUInt32(0, GetGUIDLow());
-                stmt->setUInt16(1, uint16(itr->first));
-                stmt->setUInt16(2, value);
-                stmt->setUInt16(3, max);
-                trans->Append(stmt);
-
-                break;
-            case SKILL_CHANGED:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UDP_CHAR_SKILLS);
-                stmt->setUInt16(0, value);
-                stmt->setUInt16(1, max);
-                stmt->setUInt32(2, GetGUIDLow());
-                stmt->setUInt16(3, uint16(itr->first));
-                trans->Append(stmt);
+        // new and changed skills alike
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_SKILLS);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt16(1, uint16(itr->first));
+        stmt->setUInt16(2, SKILL_VALUE(valueData));
+        stmt->setUInt16(3, SKILL_MAX(valueData));
+        batch.Append(stmt);
 
-                break;
-            default:
-                break;
-        }
         itr->second.uState = SKILL_UNCHANGED;
 
         ++itr;
     }
+
+    batch.Flush();
+    UpdateSaveStats(batch);
 }
 
 void Player::_SaveSpells(SQLTransaction& trans)
@@ -19793,10 +19953,6 @@ void Player::_SaveStats(SQLTransaction& trans)
 
     PreparedStatement* stmt = NULL;
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
-
     uint8 index = 0;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
@@ -19823,6 +19979,23 @@ void Player::_SaveStats(SQLTransaction& trans)
     stmt->setUInt32(index++, GetBaseSpellPowerBonus());
     stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + CR_CRIT_TAKEN_SPELL));
 
+    PlayerSavedRows<uint32>& saved = m_savedRows[PLAYER_SAVE_STATS];
+    saved.Begin(m_saveResult);
+    bool changed = _IsSaveRowChanged(saved, uint32(0), stmt);
+
+    PlayerSavedRows<uint32>::KeyList removed;
+    saved.Finish(removed);
+
+    if (!changed)
+    {
+        delete stmt;
+        return;
+    }
+
+    PreparedStatement* delStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
+    delStmt->setUInt32(0, GetGUIDLow());
+    trans->Append(delStmt);
+
     trans->Append(stmt);
 }
 
@@ -25294,11 +25467,8 @@ void Player::_SaveEquipmentSets(SQLTransaction& trans)
 
 void Player::_SaveBGData(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
     /* guid, bgInstanceID, bgTeam, x, y, z, o, map, taxi[0], taxi[1], mountSpell */
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PLAYER_BGDATA);
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUIDLow());
     stmt->setUInt32(1, m_bgData.bgInstanceID);
     stmt->setUInt16(2, m_bgData.bgTeam);
@@ -25310,6 +25480,24 @@ void Player::_SaveBGData(SQLTransaction& trans)
     stmt->setUInt16(8, m_bgData.taxiPath[0]);
     stmt->setUInt16(9, m_bgData.taxiPath[1]);
     stmt->setUInt16(10, m_bgData.mountSpell);
+
+    PlayerSavedRows<uint32>& saved = m_savedRows[PLAYER_SAVE_BG_DATA];
+    saved.Begin(m_saveResult);
+    bool changed = _IsSaveRowChanged(saved, uint32(0), stmt);
+
+    PlayerSavedRows<uint32>::KeyList removed;
+    saved.Finish(removed);
+
+    if (!changed)
+    {
+        delete stmt;
+        return;
+    }
+
+    PreparedStatement* delStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
+    delStmt->setUInt32(0, GetGUIDLow());
+    trans->Append(delStmt);
+
     trans->Append(stmt);
 }
 
@@ -25395,10 +25583,17 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
 
 void Player::_SaveGlyphs(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
-    stmt->setUInt32(0, GetGUIDLow());
-    trans->Append(stmt);
+    PlayerSavedRows<uint32>& saved = m_savedRows[PLAYER_SAVE_GLYPHS];
+    saved.Begin(m_saveResult);
+    PreparedStatement* stmt = NULL;
 
+    // nothing known about the stored rows, rewrite them all
+    if (!saved.IsValid())
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
+        stmt->setUInt32(0, GetGUIDLow());
+        trans->Append(stmt);
+    }
 
     for (uint8 spec = 0; spec < m_specsCount; ++spec)
     {
@@ -25412,6 +25607,30 @@ void Player::_SaveGlyphs(SQLTransaction& trans)
         for (uint8 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
             stmt->setUInt16(index++, uint16(m_Glyphs[spec][i]));
 
+        if (!_IsSaveRowChanged(saved, uint32(spec), stmt))
+        {
+            delete stmt;
+            continue;
+        }
+
+        if (saved.IsValid())
+        {
+            PreparedStatement* delStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS_BY_SPEC);
+            delStmt->setUInt32(0, GetGUIDLow());
+            delStmt->setUInt8(1, spec);
+            trans->Append(delStmt);
+        }
+
+        trans->Append(stmt);
+    }
+
+    PlayerSavedRows<uint32>::KeyList removed;
+    saved.Finish(removed);
+    for (PlayerSavedRows<uint32>::KeyList::const_iterator itr = removed.begin(); itr != removed.end(); ++itr)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS_BY_SPEC);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt8(1, uint8(*itr));
         trans->Append(stmt);
     }
 }
@@ -25957,12 +26176,20 @@ void Player::_LoadPlayerRates(PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(SQLTransaction& trans)
 {
-    if (_instanceResetTimes.empty())
+    PlayerSavedRows<uint32>& saved = m_savedRows[PLAYER_SAVE_INSTANCE_TIMES];
+    saved.Begin(m_saveResult);
+
+    // nothing known about the stored rows yet, leave them as they are
+    if (_instanceResetTimes.empty() && !saved.IsValid())
         return;
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
-    stmt->setUInt32(0, GetSession()->GetAccountId());
-    trans->Append(stmt);
+    PreparedStatement* stmt = NULL;
+    if (!saved.IsValid())
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
+        stmt->setUInt32(0, GetSession()->GetAccountId());
+        trans->Append(stmt);
+    }
 
     for (InstanceTimeMap::const_iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end(); ++itr)
     {
@@ -25970,6 +26197,31 @@ void Player::_SaveInstanceTimeRestrictions(SQLTransaction& trans)
         stmt->setUInt32(0, GetSession()->GetAccountId());
         stmt->setUInt32(1, itr->first);
         stmt->setUInt64(2, itr->second);
+
+        if (!_IsSaveRowChanged(saved, itr->first, stmt))
+        {
+            delete stmt;
+            continue;
+        }
+
+        if (saved.IsValid())
+        {
+            PreparedStatement* delStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIME);
+            delStmt->setUInt32(0, GetSession()->GetAccountId());
+            delStmt->setUInt32(1, itr->first);
+            trans->Append(delStmt);
+        }
+
+        trans->Append(stmt);
+    }
+
+    PlayerSavedRows<uint32>::KeyList removed;
+    saved.Finish(removed);
+    for (PlayerSavedRows<uint32>::KeyList::const_iterator itr = removed.begin(); itr != removed.end(); ++itr)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIME);
+        stmt->setUInt32(0, GetSession()->GetAccountId());
+        stmt->setUInt32(1, *itr);
         trans->Append(stmt);
     }
 }
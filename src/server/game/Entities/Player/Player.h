@@ -137,6 +137,94 @@ struct SpellCooldown
 typedef std::map<uint32, SpellCooldown> SpellCooldowns;
 typedef UNORDERED_MAP<uint32 /*instanceId*/, time_t/*releaseTime*/> InstanceTimeMap;
 
+// Character tables only written for rows changed since the previous save
+enum PlayerSaveTable
+{
+    PLAYER_SAVE_BG_DATA,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_STATS,
+    PLAYER_SAVE_INSTANCE_TIMES,
+    MAX_PLAYER_SAVE_TABLES
+};
+
+// Primary key of a character_aura row after the owner
+struct PlayerAuraSaveKey
+{
+    PlayerAuraSaveKey(uint64 casterGuid, uint64 itemGuid, uint32 spellId, uint8 effectMask) :
+        CasterGuid(casterGuid), ItemGuid(itemGuid), SpellId(spellId), EffectMask(effectMask) { }
+
+    bool operator<(PlayerAuraSaveKey const& right) const
+    {
+        if (CasterGuid != right.CasterGuid)
+            return CasterGuid < right.CasterGuid;
+        if (ItemGuid != right.ItemGuid)
+            return ItemGuid < right.ItemGuid;
+        if (SpellId != right.SpellId)
+            return SpellId < right.SpellId;
+        return EffectMask < right.EffectMask;
+    }
+
+    uint64 CasterGuid;
+    uint64 ItemGuid;
+    uint32 SpellId;
+    uint8 EffectMask;
+};
+
+// Parameters of the rows written to a table, keyed by the primary key part after the owner.
+// A row is only known to be stored once the transaction of the save which wrote it has committed,
+// until then it is written again. Nothing is known before a save rewrote the whole table and
+// committed, which is needed after login and after such a save failed.
+template<class Key>
+class PlayerSavedRows
+{
+    public:
+        typedef std::vector<Key> KeyList;
+
+        PlayerSavedRows() : _valid(false), _rewriting(false), _lastSaveStored(false), _save(0) { }
+
+        // starts a save which is committed with result
+        void Begin(SQLTransactionResult const& result);
+        // false if the save must delete all rows of the owner and write them again
+        bool IsValid() const { return _valid; }
+        // remembers the row of stmt, returns false if the same row is stored already
+        bool Update(Key const& key, PreparedStatement const* stmt);
+        // ends a save, returns the rows to delete: rows not written again and the deletes of a
+        // previous save which did not commit (yet)
+        void Finish(KeyList& removed);
+
+    private:
+        struct Row
+        {
+            Row() : written(0), seen(0) { }
+
+            std::vector<PreparedStatementData> parameters;
+            uint32 written;
+            uint32 seen;
+        };
+
+        typedef std::map<Key, Row> RowMap;
+
+        bool _valid;
+        bool _rewriting;                                    // the previous save rewrote the whole table
+        bool _lastSaveStored;                               // the previous save has committed
+        uint32 _save;
+        RowMap _rows;
+        KeyList _removed;                                   // rows deleted by the previous save
+        SQLTransactionResult _lastSave;
+};
+
+struct PlayerSaveStats
+{
+    PlayerSaveStats() : Saves(0), Statements(0), Rows(0), SkippedRows(0), SkippedStatements(0), SkippedBytes(0) { }
+
+    uint32 Saves;
+    uint64 Statements;                                      // statements queued by SaveToDB
+    uint64 Rows;                                            // rows of the diffed tables
+    uint64 SkippedRows;                                     // of these, rows stored already
+    uint64 SkippedStatements;                               // writes of these and of rows merged into multi-row statements
+    uint64 SkippedBytes;                                    // values of the rows stored already
+};
+
 enum TrainerSpellState
 {
     TRAINER_SPELL_GREEN = 0,
@@ -1545,6 +1633,8 @@ class Player : public Unit, public GridObject<Player>
         void SaveToDB(bool create = false);
         void SaveInventoryAndGoldToDB(SQLTransaction& trans);                    // fast save function for item/money cheating preventing
         void SaveGoldToDB(SQLTransaction& trans);
+        PlayerSaveStats const& GetSaveStats() const { return m_saveStats; }
+        void UpdateSaveStats(TransactionBatch const& batch) { m_saveStats.SkippedStatements += batch.GetRows() - batch.GetStatements(); }
 
         static void SetUInt32ValueInArray(Tokenizer& data, uint16 index, uint32 value);
         static void SetFloatValueInArray(Tokenizer& data, uint16 index, float value);
@@ -1835,7 +1925,7 @@ class Player : public Unit, public GridObject<Player>
         void RemoveFromGroup(RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT) { RemoveFromGroup(GetGroup(), GetGUID(), method); }
         void SendUpdateToOutOfRangeGroupMembers();
 
-        void SetInGuild(uint32 GuildId) { SetUInt32Value(PLAYER_GUILDID, GuildId); }
+        void SetInGuild(uint32 GuildId);
         void SetRank(uint8 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
         uint8 GetRank() const { return uint8(GetUInt32Value(PLAYER_GUILDRANK)); }
         void SetGuildIdInvited(uint32 GuildId) { m_GuildIdInvited = GuildId; }
@@ -2662,6 +2752,8 @@ class Player : public Unit, public GridObject<Player>
         void _SaveTalents(SQLTransaction& trans);
         void _SaveStats(SQLTransaction& trans);
         void _SaveInstanceTimeRestrictions(SQLTransaction& trans);
+        template<class Key>
+        bool _IsSaveRowChanged(PlayerSavedRows<Key>& saved, Key const& key, PreparedStatement const* stmt);
 
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -2900,6 +2992,11 @@ class Player : public Unit, public GridObject<Player>
         uint32 m_timeSyncServer;
 
         InstanceTimeMap _instanceResetTimes;
+
+        PlayerSavedRows<uint32> m_savedRows[MAX_PLAYER_SAVE_TABLES];
+        PlayerSavedRows<PlayerAuraSaveKey> m_savedAuras;
+        PlayerSaveStats m_saveStats;
+        SQLTransactionResult m_saveResult;                  // of the save being built or the last one
         uint32 _pendingBindId;
         uint32 _pendingBindTimer;
 
@@ -27,6 +27,7 @@
 #include "World.h"
 #include "Util.h"
 #include "AccountMgr.h"
+#include "SharedWorldPacket.h"
 
 PlayerSocial::PlayerSocial()
 {
@@ -93,6 +94,9 @@ bool PlayerSocial::AddToSocialList(uint32 friendGuid, bool ignore)
         fi.Flags |= flag;
         m_playerSocialMap[friendGuid] = fi;
     }
+
+    if (!ignore)
+        sSocialMgr->AddFriendLister(friendGuid, GetPlayerGUID());
     return true;
 }
 
@@ -107,6 +111,9 @@ void PlayerSocial::RemoveFromSocialList(uint32 friendGuid, bool ignore)
         flag = SOCIAL_FLAG_IGNORED;
 
     itr->second.Flags &= ~flag;
+    if (!ignore)
+        sSocialMgr->RemoveFriendLister(friendGuid, GetPlayerGUID());
+
     if (itr->second.Flags == 0)
     {
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHARACTER_SOCIAL);
@@ -207,6 +214,34 @@ SocialMgr::~SocialMgr()
 {
 }
 
+void SocialMgr::RemovePlayerSocial(uint32 guid)
+{
+    SocialMap::iterator itr = m_socialMap.find(guid);
+    if (itr == m_socialMap.end())
+        return;
+
+    RemoveFriendListers(itr->second);
+    m_socialMap.erase(itr);
+}
+
+void SocialMgr::RemoveFriendLister(uint32 friendGuid, uint32 listerGuid)
+{
+    SocialListerMap::iterator itr = m_friendListers.find(friendGuid);
+    if (itr == m_friendListers.end())
+        return;
+
+    itr->second.erase(listerGuid);
+    if (itr->second.empty())
+        m_friendListers.erase(itr);
+}
+
+void SocialMgr::RemoveFriendListers(PlayerSocial const& social)
+{
+    for (PlayerSocialMap::const_iterator itr = social.m_playerSocialMap.begin(); itr != social.m_playerSocialMap.end(); ++itr)
+        if (itr->second.Flags & SOCIAL_FLAG_FRIEND)
+            RemoveFriendLister(itr->first, social.GetPlayerGUID());
+}
+
 void SocialMgr::GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo &friendInfo)
 {
     if (!player)
@@ -302,22 +337,31 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket* packet)
     AccountTypes gmLevelInWhoList = AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST));
     bool allowTwoSideWhoList = sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST);
 
-    for (SocialMap::const_iterator itr = m_socialMap.begin(); itr != m_socialMap.end(); ++itr)
+    SocialListerMap::const_iterator listers = m_friendListers.find(guid);
+    if (listers == m_friendListers.end())
+        return;
+
+    std::vector<uint64> guids;
+    guids.reserve(listers->second.size());
+    for (SocialListerSet::const_iterator itr = listers->second.begin(); itr != listers->second.end(); ++itr)
+        guids.push_back(MAKE_NEW_GUID(*itr, 0, HIGHGUID_PLAYER));
+
+    std::vector<Player*> friends;
+    ObjectAccessor::FindPlayers(guids, friends);
+
+    SharedWorldPacketSender sender(packet);
+    for (std::vector<Player*>::const_iterator itr = friends.begin(); itr != friends.end(); ++itr)
     {
-        PlayerSocialMap::const_iterator itr2 = itr->second.m_playerSocialMap.find(guid);
-        if (itr2 != itr->second.m_playerSocialMap.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND))
+        Player* pFriend = *itr;
+
+        // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
+        // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
+        if (pFriend && pFriend->IsInWorld() &&
+            (!AccountMgr::IsPlayerAccount(pFriend->GetSession()->GetSecurity()) ||
+            ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
+            player->IsVisibleGloballyFor(pFriend))
         {
-            Player* pFriend = ObjectAccessor::FindPlayer(MAKE_NEW_GUID(itr->first, 0, HIGHGUID_PLAYER));
-
-            // PLAYER see his team only and PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
-            // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
-            if (pFriend && pFriend->IsInWorld() &&
-                (!AccountMgr::IsPlayerAccount(pFriend->GetSession()->GetSecurity()) ||
-                ((pFriend->GetTeam() == team || allowTwoSideWhoList) && security <= gmLevelInWhoList)) &&
-                player->IsVisibleGloballyFor(pFriend))
-            {
-                pFriend->GetSession()->SendPacket(packet);
-            }
+            sender.SendTo(pFriend->GetSession());
         }
     }
 }
@@ -327,6 +371,10 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, uint32 guid)
     PlayerSocial *social = &m_socialMap[guid];
     social->SetPlayerGUID(guid);
 
+    // a reload replaces the old list
+    RemoveFriendListers(*social);
+    social->m_playerSocialMap.clear();
+
     if (!result)
         return social;
 
@@ -343,6 +391,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, uint32 guid)
         note = fields[2].GetString();
 
         social->m_playerSocialMap[friendGuid] = FriendInfo(flags, note);
+        if (flags & SOCIAL_FLAG_FRIEND)
+            AddFriendLister(friendGuid, guid);
 
         // client's friends list and ignore list limit
         if (social->m_playerSocialMap.size() >= (SOCIALMGR_FRIEND_LIMIT + SOCIALMGR_IGNORE_LIMIT))
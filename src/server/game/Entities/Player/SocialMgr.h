@@ -63,6 +63,8 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::set<uint32> SocialListerSet;
+typedef UNORDERED_MAP<uint32, SocialListerSet> SocialListerMap;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -132,7 +134,7 @@ class SocialMgr
 
     public:
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
 
         void GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo &friendInfo);
         // Packet management
@@ -142,7 +144,14 @@ class SocialMgr
         // Loading
         PlayerSocial *LoadFromDB(PreparedQueryResult result, uint32 guid);
     private:
+        friend class PlayerSocial;
+        // reverse index of the loaded social lists: friend guid -> guids of the players having him as friend
+        void AddFriendLister(uint32 friendGuid, uint32 listerGuid) { m_friendListers[friendGuid].insert(listerGuid); }
+        void RemoveFriendLister(uint32 friendGuid, uint32 listerGuid);
+        void RemoveFriendListers(PlayerSocial const& social);
+
         SocialMap m_socialMap;
+        SocialListerMap m_friendListers;
 };
 
 #define sSocialMgr ACE_Singleton<SocialMgr, ACE_Null_Mutex>::instance()
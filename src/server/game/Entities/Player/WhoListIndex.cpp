@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "WhoListIndex.h"
+#include "Player.h"
+#include "WorldSession.h"
+#include "GuildMgr.h"
+#include "DBCStores.h"
+#include "AccountMgr.h"
+#include "Util.h"
+
+void WhoListIndex::AddPlayer(Player const* player)
+{
+    Entry entry;
+    entry.player = player;
+    entry.name = player->GetName();
+    if (!Utf8toWStr(entry.name, entry.lowerName))
+        entry.lowerName.clear();
+    wstrToLower(entry.lowerName);
+    entry.guildId = player->GetGuildId();
+    entry.teamIndex = player->GetTeamId();
+    entry.level = player->getLevel();
+    entry.class_ = player->getClass();
+    entry.race = player->getRace();
+    entry.gender = player->getGender();
+    entry.zoneId = player->GetZoneId();
+
+    uint32 guidLow = player->GetGUIDLow();
+
+    TRINITY_WRITE_GUARD(LockType, m_lock);
+    EntryMap::iterator itr = m_entries.find(guidLow);
+    if (itr != m_entries.end())
+    {
+        Unlink(guidLow, itr->second);
+        m_entries.erase(itr);
+    }
+
+    m_entries[guidLow] = entry;
+    m_byTeam[entry.teamIndex].insert(guidLow);
+    m_byLevel[entry.level].insert(guidLow);
+    if (entry.class_ < MAX_CLASSES)
+        m_byClass[entry.class_].insert(guidLow);
+    if (entry.race < MAX_RACES)
+        m_byRace[entry.race].insert(guidLow);
+    m_byZone[entry.zoneId].insert(guidLow);
+}
+
+void WhoListIndex::RemovePlayer(uint32 guidLow)
+{
+    TRINITY_WRITE_GUARD(LockType, m_lock);
+    EntryMap::iterator itr = m_entries.find(guidLow);
+    if (itr == m_entries.end())
+        return;
+
+    Unlink(guidLow, itr->second);
+    m_entries.erase(itr);
+}
+
+void WhoListIndex::Unlink(uint32 guidLow, Entry const& entry)
+{
+    m_byTeam[entry.teamIndex].erase(guidLow);
+    m_byLevel[entry.level].erase(guidLow);
+    if (entry.class_ < MAX_CLASSES)
+        m_byClass[entry.class_].erase(guidLow);
+    if (entry.race < MAX_RACES)
+        m_byRace[entry.race].erase(guidLow);
+
+    ZoneMap::iterator zoneItr = m_byZone.find(entry.zoneId);
+    if (zoneItr != m_byZone.end())
+    {
+        zoneItr->second.erase(guidLow);
+        if (zoneItr->second.empty())
+            m_byZone.erase(zoneItr);
+    }
+}
+
+void WhoListIndex::UpdateLevel(uint32 guidLow, uint8 level)
+{
+    TRINITY_WRITE_GUARD(LockType, m_lock);
+    EntryMap::iterator itr = m_entries.find(guidLow);
+    if (itr == m_entries.end() || itr->second.level == level)
+        return;
+
+    m_byLevel[itr->second.level].erase(guidLow);
+    itr->second.level = level;
+    m_byLevel[level].insert(guidLow);
+}
+
+void WhoListIndex::UpdateZone(uint32 guidLow, uint32 zoneId)
+{
+    TRINITY_WRITE_GUARD(LockType, m_lock);
+    EntryMap::iterator itr = m_entries.find(guidLow);
+    if (itr == m_entries.end() || itr->second.zoneId == zoneId)
+        return;
+
+    ZoneMap::iterator zoneItr = m_byZone.find(itr->second.zoneId);
+    if (zoneItr != m_byZone.end())
+    {
+        zoneItr->second.erase(guidLow);
+        if (zoneItr->second.empty())
+            m_byZone.erase(zoneItr);
+    }
+
+    itr->second.zoneId = zoneId;
+    m_byZone[zoneId].insert(guidLow);
+}
+
+void WhoListIndex::UpdateGuild(uint32 guidLow, uint32 guildId)
+{
+    TRINITY_WRITE_GUARD(LockType, m_lock);
+    EntryMap::iterator itr = m_entries.find(guidLow);
+    if (itr != m_entries.end())
+        itr->second.guildId = guildId;
+}
+
+/// Returns the smallest index bucket (or union of buckets) that every match must be in,
+/// NULL when no restriction narrows the search below the full player list.
+WhoListIndex::GuidSet const* WhoListIndex::SelectCandidates(WhoListQuery const& query, GuidSet& scratch) const
+{
+    enum { BY_ALL, BY_ZONE, BY_LEVEL, BY_CLASS, BY_RACE, BY_TEAM };
+
+    uint8 best = BY_ALL;
+    size_t bestSize = m_entries.size();
+
+    if (!query.Zones.empty())
+    {
+        size_t size = 0;
+        for (std::vector<uint32>::const_iterator itr = query.Zones.begin(); itr != query.Zones.end(); ++itr)
+        {
+            ZoneMap::const_iterator zoneItr = m_byZone.find(*itr);
+            if (zoneItr != m_byZone.end())
+                size += zoneItr->second.size();
+        }
+
+        if (size < bestSize)
+        {
+            best = BY_ZONE;
+            bestSize = size;
+        }
+    }
+
+    uint32 levelMax = std::min<uint32>(query.LevelMax, STRONG_MAX_LEVEL);
+    if (query.LevelMin > 0 || levelMax < STRONG_MAX_LEVEL)
+    {
+        size_t size = 0;
+        for (uint32 level = query.LevelMin; level <= levelMax; ++level)
+            size += m_byLevel[level].size();
+
+        if (size < bestSize)
+        {
+            best = BY_LEVEL;
+            bestSize = size;
+        }
+    }
+
+    size_t classSize = 0;
+    for (uint8 class_ = 0; class_ < MAX_CLASSES; ++class_)
+        if (query.ClassMask & (1 << class_))
+            classSize += m_byClass[class_].size();
+    if (classSize < bestSize)
+    {
+        best = BY_CLASS;
+        bestSize = classSize;
+    }
+
+    size_t raceSize = 0;
+    for (uint8 race = 0; race < MAX_RACES; ++race)
+        if (query.RaceMask & (1 << race))
+            raceSize += m_byRace[race].size();
+    if (raceSize < bestSize)
+    {
+        best = BY_RACE;
+        bestSize = raceSize;
+    }
+
+    if (query.Team < TEAM_NEUTRAL && m_byTeam[query.Team].size() < bestSize)
+        best = BY_TEAM;
+
+    switch (best)
+    {
+        case BY_ZONE:
+            for (std::vector<uint32>::const_iterator itr = query.Zones.begin(); itr != query.Zones.end(); ++itr)
+            {
+                ZoneMap::const_iterator zoneItr = m_byZone.find(*itr);
+                if (zoneItr != m_byZone.end())
+                    scratch.insert(zoneItr->second.begin(), zoneItr->second.end());
+            }
+            return &scratch;
+        case BY_LEVEL:
+            for (uint32 level = query.LevelMin; level <= levelMax; ++level)
+                scratch.insert(m_byLevel[level].begin(), m_byLevel[level].end());
+            return &scratch;
+        case BY_CLASS:
+            for (uint8 class_ = 0; class_ < MAX_CLASSES; ++class_)
+                if (query.ClassMask & (1 << class_))
+                    scratch.insert(m_byClass[class_].begin(), m_byClass[class_].end());
+            return &scratch;
+        case BY_RACE:
+            for (uint8 race = 0; race < MAX_RACES; ++race)
+                if (query.RaceMask & (1 << race))
+                    scratch.insert(m_byRace[race].begin(), m_byRace[race].end());
+            return &scratch;
+        case BY_TEAM:
+            return &m_byTeam[query.Team];
+        default:
+            return NULL;
+    }
+}
+
+void WhoListIndex::Query(WhoListQuery const& query, WhoListResults& results) const
+{
+    if (!query.MaxResults || query.LevelMin > query.LevelMax)
+        return;
+
+    // guild names are resolved per query so renamed and disbanded guilds never go stale
+    typedef UNORDERED_MAP<uint32, std::pair<std::string, std::wstring> > GuildNameCache;
+    GuildNameCache guildNames;
+
+    TRINITY_READ_GUARD(LockType, m_lock);
+
+    GuidSet scratch;
+    GuidSet const* candidates = SelectCandidates(query, scratch);
+
+    EntryMap::const_iterator entryItr = m_entries.begin();
+    GuidSet::const_iterator guidItr;
+    if (candidates)
+        guidItr = candidates->begin();
+
+    while (results.size() < query.MaxResults)
+    {
+        Entry const* entry;
+        if (candidates)
+        {
+            if (guidItr == candidates->end())
+                break;
+
+            EntryMap::const_iterator itr = m_entries.find(*guidItr++);
+            if (itr == m_entries.end())
+                continue;
+            entry = &itr->second;
+        }
+        else
+        {
+            if (entryItr == m_entries.end())
+                break;
+            entry = &(entryItr++)->second;
+        }
+
+        if (query.Team < TEAM_NEUTRAL && entry->teamIndex != query.Team)
+            continue;
+
+        if (entry->level < query.LevelMin || entry->level > query.LevelMax)
+            continue;
+
+        if (!(query.ClassMask & (1 << entry->class_)))
+            continue;
+
+        if (!(query.RaceMask & (1 << entry->race)))
+            continue;
+
+        if (!query.Zones.empty() && std::find(query.Zones.begin(), query.Zones.end(), entry->zoneId) == query.Zones.end())
+            continue;
+
+        if (!query.PlayerName.empty() && entry->lowerName.find(query.PlayerName) == std::wstring::npos)
+            continue;
+
+        GuildNameCache::iterator guildItr = guildNames.find(entry->guildId);
+        if (guildItr == guildNames.end())
+        {
+            std::pair<std::string, std::wstring> names;
+            names.first = sGuildMgr->GetGuildNameById(entry->guildId);
+            if (Utf8toWStr(names.first, names.second))
+                wstrToLower(names.second);
+            guildItr = guildNames.insert(GuildNameCache::value_type(entry->guildId, names)).first;
+        }
+
+        std::wstring const& lowerGuildName = guildItr->second.second;
+        if (!query.GuildName.empty() && lowerGuildName.find(query.GuildName) == std::wstring::npos)
+            continue;
+
+        if (!query.Strings.empty())
+        {
+            std::string areaName;
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry->zoneId))
+                areaName = areaEntry->area_name[query.Locale];
+
+            bool show = false;
+            for (std::vector<std::wstring>::const_iterator itr = query.Strings.begin(); itr != query.Strings.end(); ++itr)
+            {
+                if (lowerGuildName.find(*itr) != std::wstring::npos ||
+                    entry->lowerName.find(*itr) != std::wstring::npos ||
+                    Utf8FitTo(areaName, *itr))
+                {
+                    show = true;
+                    break;
+                }
+            }
+
+            if (!show)
+                continue;
+        }
+
+        // the entry is removed before its player is deleted, so the pointer is valid under the read lock
+        Player const* player = entry->player;
+        if (uint32(player->GetSession()->GetSecurity()) > query.MaxSecurity)
+            continue;
+
+        if (!player->IsInWorld() || !player->IsVisibleGloballyFor(query.Requester))
+            continue;
+
+        WhoListResult result;
+        result.PlayerName = entry->name;
+        result.GuildName = guildItr->second.first;
+        result.Level = entry->level;
+        result.Class = entry->class_;
+        result.Race = entry->race;
+        result.Gender = entry->gender;
+        result.ZoneId = entry->zoneId;
+        results.push_back(result);
+    }
+}
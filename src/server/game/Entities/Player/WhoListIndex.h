@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TRINITY_WHOLISTINDEX_H
+#define __TRINITY_WHOLISTINDEX_H
+
+#include <ace/Singleton.h>
+#include "Common.h"
+#include "SharedDefines.h"
+#include "DBCEnums.h"
+
+class Player;
+
+struct WhoListResult
+{
+    std::string PlayerName;
+    std::string GuildName;
+    uint32 Level;
+    uint32 Class;
+    uint32 Race;
+    uint8 Gender;
+    uint32 ZoneId;
+};
+
+typedef std::vector<WhoListResult> WhoListResults;
+
+struct WhoListQuery
+{
+    WhoListQuery() : LevelMin(0), LevelMax(STRONG_MAX_LEVEL), RaceMask(~uint32()), ClassMask(~uint32()),
+        Team(TEAM_NEUTRAL), MaxSecurity(~uint32()), Locale(LOCALE_enUS), MaxResults(0), Requester(NULL) { }
+
+    uint32 LevelMin;
+    uint32 LevelMax;
+    uint32 RaceMask;
+    uint32 ClassMask;
+    std::vector<uint32> Zones;                              // empty = any zone
+    std::wstring PlayerName;                                // lowercased, empty = any
+    std::wstring GuildName;                                 // lowercased, empty = any
+    std::vector<std::wstring> Strings;                      // lowercased, matched against player, guild or zone name
+    TeamId Team;                                            // TEAM_NEUTRAL = both teams
+    uint32 MaxSecurity;                                     // hide players with a higher account security
+    LocaleConstant Locale;
+    uint32 MaxResults;
+    Player const* Requester;
+};
+
+/// Secondary indexes over the online players used by the /who list.
+/// Players are added on login and removed on logout; level, zone and guild
+/// changes are pushed by the player so queries never walk the whole player
+/// map under the ObjectAccessor lock. Entries hold the player pointer, so
+/// RemovePlayer must be called before the player is deleted.
+class WhoListIndex
+{
+    friend class ACE_Singleton<WhoListIndex, ACE_Null_Mutex>;
+
+    struct Entry
+    {
+        Player const* player;
+        std::string name;
+        std::wstring lowerName;
+        uint32 guildId;
+        uint8 teamIndex;
+        uint8 level;
+        uint8 class_;
+        uint8 race;
+        uint8 gender;
+        uint32 zoneId;
+    };
+
+    typedef std::set<uint32> GuidSet;
+    typedef std::map<uint32, Entry> EntryMap;
+    typedef UNORDERED_MAP<uint32, GuidSet> ZoneMap;
+
+    WhoListIndex() { }
+    ~WhoListIndex() { }
+
+    public:
+        void AddPlayer(Player const* player);
+        void RemovePlayer(uint32 guidLow);
+
+        void UpdateLevel(uint32 guidLow, uint8 level);
+        void UpdateZone(uint32 guidLow, uint32 zoneId);
+        void UpdateGuild(uint32 guidLow, uint32 guildId);
+
+        /// Appends matching players to results, at most query.MaxResults of them
+        void Query(WhoListQuery const& query, WhoListResults& results) const;
+
+    private:
+        void Unlink(uint32 guidLow, Entry const& entry);
+        GuidSet const* SelectCandidates(WhoListQuery const& query, GuidSet& scratch) const;
+
+        EntryMap m_entries;
+        GuidSet m_byTeam[TEAM_NEUTRAL];
+        GuidSet m_byLevel[STRONG_MAX_LEVEL + 1];
+        GuidSet m_byClass[MAX_CLASSES];
+        GuidSet m_byRace[MAX_RACES];
+        ZoneMap m_byZone;
+
+        typedef ACE_RW_Thread_Mutex LockType;
+        mutable LockType m_lock;
+};
+
+#define sWhoListIndex ACE_Singleton<WhoListIndex, ACE_Null_Mutex>::instance()
+
+#endif
@@ -60,6 +60,7 @@
 #include "UpdateFieldFlags.h"
 #include "Util.h"
 #include "Vehicle.h"
+#include "WhoListIndex.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -174,6 +175,9 @@ Unit::Unit(bool isWorldObject): WorldObject(isWorldObject)
     , m_AutoRepeatFirstCast(false)
     , m_procDeep(0)
     , m_removedAurasCount(0)
+    , m_procAuraFlags(0)
+    , m_procAurasGeneration(sSpellMgr->GetProcDataGeneration())
+    , m_auraModifierTotalsGeneration(sSpellMgr->GetSpellGroupDataGeneration())
     , i_motionMaster(this)
     , m_ThreatManager(this)
     , m_vehicle(NULL)
@@ -3277,6 +3281,8 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    _AddProcAura(aurApp);
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -3351,6 +3357,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAura(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -3435,6 +3442,65 @@ void Unit::_UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode)
     ASSERT(false);
 }
 
+// Proc flags IsTriggeredAtSpellProcEvent tests an aura with, 0 if the aura can never pass it
+static uint32 GetProcAuraFlags(SpellInfo const* spellInfo)
+{
+    // handled by the new proc system
+    if (sSpellMgr->GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(spellInfo->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
+void Unit::_AddProcAura(AuraApplication* aurApp)
+{
+    SpellInfo const* spellInfo = aurApp->GetBase()->GetSpellInfo();
+    uint32 procFlags = GetProcAuraFlags(spellInfo);
+    if (!procFlags)
+        return;
+
+    ProcAuraEntry entry;
+    entry.spellId = spellInfo->Id;
+    entry.procFlags = procFlags;
+    entry.aurApp = aurApp;
+
+    // same position as in m_appliedAuras: after all applications of lower or equal spell id
+    ProcAuraList::iterator itr = std::upper_bound(m_procAuras.begin(), m_procAuras.end(), entry.spellId,
+        [](uint32 spellId, ProcAuraEntry const& right) { return spellId < right.spellId; });
+    m_procAuras.insert(itr, entry);
+    m_procAuraFlags |= procFlags;
+}
+
+void Unit::_RemoveProcAura(AuraApplication* aurApp)
+{
+    for (ProcAuraList::iterator itr = m_procAuras.begin(); itr != m_procAuras.end(); ++itr)
+    {
+        if (itr->aurApp != aurApp)
+            continue;
+
+        m_procAuras.erase(itr);
+
+        m_procAuraFlags = 0;
+        for (ProcAuraList::const_iterator flagItr = m_procAuras.begin(); flagItr != m_procAuras.end(); ++flagItr)
+            m_procAuraFlags |= flagItr->procFlags;
+        return;
+    }
+}
+
+void Unit::_RebuildProcAuras()
+{
+    m_procAuras.clear();
+    m_procAuraFlags = 0;
+    m_procAurasGeneration = sSpellMgr->GetProcDataGeneration();
+
+    for (AuraApplicationMap::const_iterator itr = m_appliedAuras.begin(); itr != m_appliedAuras.end(); ++itr)
+        _AddProcAura(itr->second);
+}
+
 void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -3468,6 +3534,17 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    _InvalidateAuraModifierTotals(aurEff->GetAuraType());
+}
+
+void Unit::_InvalidateAuraModifierTotals(AuraType auratype)
+{
+    if (m_auraModifierTotals.empty())
+        return;
+
+    // keys of one aura type are contiguous, see GetAuraModifierTotals
+    m_auraModifierTotals.erase(m_auraModifierTotals.lower_bound(uint64(auratype) << 40), m_auraModifierTotals.lower_bound(uint64(auratype + 1) << 40));
 }
 
 // All aura base removes should go threw this function!
@@ -4393,102 +4470,123 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
     return dots;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+Unit::AuraModifierTotals Unit::CalculateAuraModifierTotals(AuraType auratype, AuraModifierFilter filter, uint32 miscValue) const
 {
     std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
+    AuraModifierTotals totals;
+    totals.modifier = 0;
+    totals.multiplier = 1.0f;
+    totals.maxPositive = 0;
+    totals.maxNegative = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-            modifier += (*i)->GetAmount();
+    {
+        if (filter == AURA_MODIFIER_FILTER_MISC_MASK && !((*i)->GetMiscValue() & miscValue))
+            continue;
+        if (filter == AURA_MODIFIER_FILTER_MISC_VALUE && (*i)->GetMiscValue() != int32(miscValue))
+            continue;
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+        int32 amount = (*i)->GetAmount();
+        if (amount > totals.maxPositive)
+            totals.maxPositive = amount;
+        if (amount < totals.maxNegative)
+            totals.maxNegative = amount;
 
-    return modifier;
-}
+        // the unfiltered multiplier has always ignored the Same Effect Stack Rule
+        if (filter == AURA_MODIFIER_FILTER_NONE)
+            AddPct(totals.multiplier, amount);
 
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
-{
-    float multiplier = 1.0f;
+        // Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroup
+        // If the Aura Effect does not have this Stack Rule, it returns false so we can add to the totals as usual
+        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), amount, SameEffectSpellGroup))
+        {
+            totals.modifier += amount;
+            if (filter != AURA_MODIFIER_FILTER_NONE)
+                AddPct(totals.multiplier, amount);
+        }
+    }
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
+    // Add the highest of the Same Effect Stack Rule SpellGroups
+    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+    {
+        totals.modifier += itr->second;
+        if (filter != AURA_MODIFIER_FILTER_NONE)
+            AddPct(totals.multiplier, itr->second);
+    }
 
-    return multiplier;
+    return totals;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
+Unit::AuraModifierTotals const& Unit::GetAuraModifierTotals(AuraType auratype, AuraModifierFilter filter, uint32 miscValue) const
 {
-    int32 modifier = 0;
+    static AuraModifierTotals const noTotals = { 0, 1.0f, 0, 0 };
+    if (m_modAuras[auratype].empty())
+        return noTotals;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    // stack rules decide which amounts count, totals calculated with old rules are wrong
+    if (m_auraModifierTotalsGeneration != sSpellMgr->GetSpellGroupDataGeneration())
     {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
+        m_auraModifierTotals.clear();
+        m_auraModifierTotalsGeneration = sSpellMgr->GetSpellGroupDataGeneration();
     }
 
-    return modifier;
-}
+    uint64 key = (uint64(auratype) << 40) | (uint64(filter) << 32) | miscValue;
+    AuraModifierTotalsMap::iterator itr = m_auraModifierTotals.find(key);
+    if (itr == m_auraModifierTotals.end())
+        return m_auraModifierTotals.insert(AuraModifierTotalsMap::value_type(key, CalculateAuraModifierTotals(auratype, filter, miscValue))).first->second;
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
-{
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+#ifdef TRINITY_DEBUG
+    // an amount changed without going through AuraEffect::ChangeAmount/SetAmount or _RegisterAuraEffect
+    AuraModifierTotals totals = CalculateAuraModifierTotals(auratype, filter, miscValue);
+    if (totals.modifier != itr->second.modifier || totals.multiplier != itr->second.multiplier ||
+        totals.maxPositive != itr->second.maxPositive || totals.maxNegative != itr->second.maxNegative)
+    {
+        sLog->outError(LOG_FILTER_UNITS, "Unit::GetAuraModifierTotals: stale totals for unit " UI64FMTD " aura type %u filter %u misc %u: cached %i/%f/%i/%i, actual %i/%f/%i/%i",
+            GetGUID(), uint32(auratype), uint32(filter), miscValue, itr->second.modifier, itr->second.multiplier, itr->second.maxPositive, itr->second.maxNegative,
+            totals.modifier, totals.multiplier, totals.maxPositive, totals.maxNegative);
+        itr->second = totals;
+    }
+#endif
 
-    return modifier;
+    return itr->second;
 }
 
-int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_NONE, 0).modifier;
+}
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_NONE, 0).multiplier;
+}
 
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() & misc_mask)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                modifier += (*i)->GetAmount();
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_NONE, 0).maxPositive;
+}
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_NONE, 0).maxNegative;
+}
 
-    return modifier;
+int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if (((*i)->GetMiscValue() & misc_mask))
-        {
-            // Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroup
-            // If the Aura Effect does not have this Stack Rule, it returns false so we can add to the multiplier as usual
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
-        }
-    }
-    // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
-
-    return multiplier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, const AuraEffect* except) const
 {
+    if (!except)
+        return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).maxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -4503,82 +4601,27 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                modifier += (*i)->GetAmount();
-    }
-
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
-
-    return modifier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
-    }
-
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
-
-    return multiplier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -13801,7 +13844,10 @@ void Unit::SetLevel(uint8 lvl)
         ToPlayer()->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
 
     if (GetTypeId() == TYPEID_PLAYER)
+    {
         sWorld->UpdateCharacterNameDataLevel(ToPlayer()->GetGUIDLow(), lvl);
+        sWhoListIndex->UpdateLevel(ToPlayer()->GetGUIDLow(), lvl);
+    }
 }
 
 void Unit::SetHealth(uint32 val)
@@ -14335,6 +14381,12 @@ bool Unit::isFrozen() const
 
 struct ProcTriggeredData
 {
+    ProcTriggeredData()
+        : aura(NULL)
+    {
+        effMask = 0;
+        spellProcEvent = NULL;
+    }
     ProcTriggeredData(Aura* _aura)
         : aura(_aura)
     {
@@ -14346,7 +14398,32 @@ struct ProcTriggeredData
     uint32 effMask;
 };
 
-typedef std::list< ProcTriggeredData > ProcTriggeredList;
+// Auras triggered by one proc event; the first few are stored inline, only longer lists allocate
+class ProcTriggeredList
+{
+    public:
+        ProcTriggeredList() : m_size(0) { }
+
+        void push_back(ProcTriggeredData const& data)
+        {
+            if (m_size < INLINE_SIZE)
+                m_inline[m_size] = data;
+            else
+                m_overflow.push_back(data);
+            ++m_size;
+        }
+
+        bool empty() const { return !m_size; }
+        size_t size() const { return m_size; }
+        ProcTriggeredData const& operator[](size_t index) const { return index < INLINE_SIZE ? m_inline[index] : m_overflow[index - INLINE_SIZE]; }
+
+    private:
+        enum { INLINE_SIZE = 8 };
+
+        ProcTriggeredData m_inline[INLINE_SIZE];
+        std::vector<ProcTriggeredData> m_overflow;
+        size_t m_size;
+};
 
 // List of auras that CAN be trigger but may not exist in spell_proc_event
 // in most case need for drop charges
@@ -14528,57 +14605,67 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     DamageInfo damageInfo = DamageInfo(actor, actionTarget, damage, procSpell, procSpell ? SpellSchoolMask(procSpell->SchoolMask) : SPELL_SCHOOL_MASK_NORMAL, SPELL_DIRECT_DAMAGE);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, NULL, &damageInfo, NULL /*HealInfo*/);
 
+    if (m_procAurasGeneration != sSpellMgr->GetProcDataGeneration())
+        _RebuildProcAuras();
+
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras sharing a proc flag with the event can pass IsTriggeredAtSpellProcEvent
+    if (procFlag & m_procAuraFlags)
     {
-        // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
-            continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
-        // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
-        bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+        for (ProcAuraList::const_iterator itr = m_procAuras.begin(); itr != m_procAuras.end(); ++itr)
+        {
+            if (!(itr->procFlags & procFlag))
+                continue;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+            // Do not allow auras to proc from effect triggered by itself
+            if (procAura && procAura->Id == itr->spellId)
+                continue;
+            AuraApplication* aurApp = itr->aurApp;
+            ProcTriggeredData triggerData(aurApp->GetBase());
+            // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
+            bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
+            if (isVictim)
+                procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        // only auras that has triggered spell should proc from fully absorbed damage
-        if (procExtra & PROC_EX_ABSORB && isVictim)
-            if (damage || spellProto->Effects[EFFECT_0].TriggerSpell || spellProto->Effects[EFFECT_1].TriggerSpell || spellProto->Effects[EFFECT_2].TriggerSpell)
-                active = true;
+            SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
-        if (!IsTriggeredAtSpellProcEvent(target, triggerData.aura, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent))
-            continue;
+            // only auras that has triggered spell should proc from fully absorbed damage
+            if (procExtra & PROC_EX_ABSORB && isVictim)
+                if (damage || spellProto->Effects[EFFECT_0].TriggerSpell || spellProto->Effects[EFFECT_1].TriggerSpell || spellProto->Effects[EFFECT_2].TriggerSpell)
+                    active = true;
 
-        // do checks using conditions table
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
-        ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
-        if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
-            continue;
+            if (!IsTriggeredAtSpellProcEvent(target, triggerData.aura, procSpell, procFlag, procExtra, attType, isVictim, active, triggerData.spellProcEvent))
+                continue;
 
-        // Triggered spells not triggering additional spells
-        bool triggered = !(spellProto->AttributesEx3 & SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED) ?
-            (procExtra & PROC_EX_INTERNAL_TRIGGERED && !(procFlag & PROC_FLAG_DONE_TRAP_ACTIVATION)) : false;
+            // do checks using conditions table
+            ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
+            ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
+            if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
+                continue;
 
-        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        {
-            if (itr->second->HasEffect(i))
+            // Triggered spells not triggering additional spells
+            bool triggered = !(spellProto->AttributesEx3 & SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED) ?
+                (procExtra & PROC_EX_INTERNAL_TRIGGERED && !(procFlag & PROC_FLAG_DONE_TRAP_ACTIVATION)) : false;
+
+            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
-                // Skip this auras
-                if (isNonTriggerAura[aurEff->GetAuraType()])
-                    continue;
-                // If not trigger by default and spellProcEvent == NULL - skip
-                if (!isTriggerAura[aurEff->GetAuraType()] && triggerData.spellProcEvent == NULL)
-                    continue;
-                // Some spells must always trigger
-                if (!triggered || isAlwaysTriggeredAura[aurEff->GetAuraType()])
-                    triggerData.effMask |= 1<<i;
+                if (aurApp->HasEffect(i))
+                {
+                    AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
+                    // Skip this auras
+                    if (isNonTriggerAura[aurEff->GetAuraType()])
+                        continue;
+                    // If not trigger by default and spellProcEvent == NULL - skip
+                    if (!isTriggerAura[aurEff->GetAuraType()] && triggerData.spellProcEvent == NULL)
+                        continue;
+                    // Some spells must always trigger
+                    if (!triggered || isAlwaysTriggeredAura[aurEff->GetAuraType()])
+                        triggerData.effMask |= 1<<i;
+                }
             }
+            if (triggerData.effMask)
+                procTriggered.push_back(triggerData);
         }
-        if (triggerData.effMask)
-            procTriggered.push_front(triggerData);
     }
 
     // Nothing found
@@ -14589,9 +14676,11 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     if (procExtra & (PROC_EX_INTERNAL_TRIGGERED | PROC_EX_INTERNAL_CANT_PROC))
         SetCantProc(true);
 
-    // Handle effects proceed this time
-    for (ProcTriggeredList::const_iterator i = procTriggered.begin(); i != procTriggered.end(); ++i)
+    // Handle effects proceed this time, latest found first
+    for (size_t index = procTriggered.size(); index > 0; --index)
     {
+        ProcTriggeredData const* i = &procTriggered[index - 1];
+
         // look for aura in auras list, it may be removed while proc event processing
         if (i->aura->IsRemoved())
             continue;
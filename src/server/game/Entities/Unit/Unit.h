@@ -1216,6 +1216,31 @@ class Unit : public WorldObject
         typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
         typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
+        struct ProcAuraEntry
+        {
+            uint32 spellId;
+            uint32 procFlags;                               // spell_proc_event procFlags, or the spell's own
+            AuraApplication* aurApp;
+        };
+        typedef std::vector<ProcAuraEntry> ProcAuraList;
+
+        // which effects of an aura type the GetTotal/GetMax aura modifier getters take into account
+        enum AuraModifierFilter
+        {
+            AURA_MODIFIER_FILTER_NONE       = 0,
+            AURA_MODIFIER_FILTER_MISC_MASK  = 1,
+            AURA_MODIFIER_FILTER_MISC_VALUE = 2
+        };
+
+        struct AuraModifierTotals
+        {
+            int32 modifier;                                 // GetTotalAuraModifier*
+            float multiplier;                               // GetTotalAuraMultiplier*
+            int32 maxPositive;                              // GetMaxPositiveAuraModifier*
+            int32 maxNegative;                              // GetMaxNegativeAuraModifier*
+        };
+        typedef std::map<uint64, AuraModifierTotals> AuraModifierTotalsMap;
+
         typedef std::list<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication *> AuraApplicationList;
@@ -1742,10 +1767,14 @@ class Unit : public WorldObject
         void _ApplyAura(AuraApplication * aurApp, uint8 effMask);
         void _UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMode);
         void _UnapplyAura(AuraApplication * aurApp, AuraRemoveMode removeMode);
+        void _AddProcAura(AuraApplication* aurApp);
+        void _RemoveProcAura(AuraApplication* aurApp);
+        void _RebuildProcAuras();
         void _RemoveNoStackAuraApplicationsDueToAura(Aura* aura);
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void _InvalidateAuraModifierTotals(AuraType auratype);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -2272,6 +2301,11 @@ class Unit : public WorldObject
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
+        ProcAuraList m_procAuras;                  // applied auras ProcDamageAndSpellFor can trigger, in m_appliedAuras order
+        uint32 m_procAuraFlags;                    // all proc flags of m_procAuras
+        uint32 m_procAurasGeneration;              // SpellMgr::GetProcDataGeneration() m_procAuras was built with
+        mutable AuraModifierTotalsMap m_auraModifierTotals;      // by aura type, filter and misc value; dropped when an effect of the type changes
+        mutable uint32 m_auraModifierTotalsGeneration;           // SpellMgr::GetSpellGroupDataGeneration() m_auraModifierTotals was built with
         uint32 m_interruptMask;
 
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
@@ -2318,6 +2352,9 @@ class Unit : public WorldObject
 
         void UpdateSplineMovement(uint32 t_diff);
 
+        AuraModifierTotals const& GetAuraModifierTotals(AuraType auratype, AuraModifierFilter filter, uint32 miscValue) const;
+        AuraModifierTotals CalculateAuraModifierTotals(AuraType auratype, AuraModifierFilter filter, uint32 miscValue) const;
+
         // player or player's pet
         float GetCombatRatingReduction(CombatRating cr) const;
         uint32 GetCombatRatingDamageReduction(CombatRating cr, float rate, float cap, uint32 damage) const;
@@ -170,6 +170,19 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
     return GetObjectInWorld(guid, (Unit*)NULL);
 }
 
+void ObjectAccessor::FindPlayers(std::vector<uint64> const& guids, std::vector<Player*>& players)
+{
+    players.resize(guids.size());
+
+    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
+    HashMapHolder<Player>::MapType const& m = GetPlayers();
+    for (size_t i = 0; i < guids.size(); ++i)
+    {
+        HashMapHolder<Player>::MapType::const_iterator itr = m.find(guids[i]);
+        players[i] = itr != m.end() && itr->second->IsInWorld() ? itr->second : NULL;
+    }
+}
+
 Player* ObjectAccessor::FindPlayerByName(std::string const& name)
 {
     TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
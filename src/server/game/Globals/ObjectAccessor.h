@@ -190,6 +190,8 @@ class ObjectAccessor
         static Creature* FindCreature(uint64);
         static Unit* FindUnit(uint64);
         static Player* FindPlayerByName(std::string const& name);
+        // resolves a batch of player guids under a single lock, players[i] is NULL if guids[i] is not in world
+        static void FindPlayers(std::vector<uint64> const& guids, std::vector<Player*>& players);
 
         // when using this, you must use the hashmapholder's lock
         static HashMapHolder<Player>::MapType const& GetPlayers()
@@ -222,6 +224,7 @@ class ObjectAccessor
         static void SaveAllPlayers();
 
         //non-static functions
+        // only for objects without a map (items), world objects are queued in their Map
         void AddUpdateObject(Object* obj)
         {
             TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
@@ -32,6 +32,7 @@
 #include "CreatureAI.h"
 #include "Spell.h"
 #include "WorldSession.h"
+#include "SharedWorldPacket.h"
 
 class Player;
 //class Map;
@@ -129,10 +130,11 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
+        SharedWorldPacketSender i_sender;
         MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_sender(msg)
         {
         }
         void Visit(PlayerMapType &m);
@@ -150,7 +152,7 @@ namespace Trinity
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+                i_sender.SendTo(session);
         }
     };
 
@@ -773,6 +773,9 @@ private:
 
     inline uint8 _GetLowestRankId() const { return uint8(m_ranks.size() - 1); }
 
+    // Online members (of one rank unless GUILD_RANK_NONE), resolved under a single ObjectAccessor lock
+    void _FindOnlinePlayers(std::vector<Player*>& players, uint8 rankId = GUILD_RANK_NONE) const;
+
     inline uint8 _GetPurchasedTabsSize() const { return uint8(m_bankTabs.size()); }
     inline BankTab* GetBankTab(uint8 tabId) { return tabId < m_bankTabs.size() ? m_bankTabs[tabId] : NULL; }
     inline const BankTab* GetBankTab(uint8 tabId) const { return tabId < m_bankTabs.size() ? m_bankTabs[tabId] : NULL; }
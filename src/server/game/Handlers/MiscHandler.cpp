@@ -41,6 +41,7 @@
 #include "OutdoorPvP.h"
 #include "Pet.h"
 #include "SocialMgr.h"
+#include "WhoListIndex.h"
 #include "CellImpl.h"
 #include "AccountMgr.h"
 #include "Vehicle.h"
@@ -177,17 +178,6 @@ void WorldSession::HandleGossipSelectOptionOpcode(WorldPacket& recvData)
 
 namespace
 {
-    struct Who
-    {
-        string pname;
-        string gname;
-        uint32 lvl;
-        uint32 class_;
-        uint32 race;
-        uint8 gender;
-        uint32 pzoneid;
-    };
-
     template<class Who_it>
         WorldPacket make_who_msg(Who_it whos_first, Who_it whos_last)
     {
@@ -198,13 +188,13 @@ namespace
         for (; clientcount < 50 && whos_first != whos_last; ++clientcount, ++whos_first)
         {
             auto &who = *whos_first;
-            data << who.pname;  // player name
-            data << who.gname;  // guild name
-            data << who.lvl;    // player level
-            data << who.class_; // player class
-            data << who.race;   // player race
-            data << who.gender; // player gender
-            data << who.pzoneid;    // player zone id
+            data << who.PlayerName; // player name
+            data << who.GuildName;  // guild name
+            data << who.Level;      // player level
+            data << who.Class;      // player class
+            data << who.Race;       // player race
+            data << who.Gender;     // player gender
+            data << who.ZoneId;     // player zone id
         }
         data.put( 0, clientcount );                             // insert right count, listed count
         // insert right count, online count
@@ -215,77 +205,6 @@ namespace
             );
         return move(data);
     }
-
-    template<class Func,
-            class Diff = std::ptrdiff_t>
-        struct Who_it
-        : std::iterator<std::input_iterator_tag, Who, Diff, const Who *, const Who &>
-    {
-        typedef Who_it Myt;
-
-        Who_it()
-            : func(nullptr)
-        {
-        }
-
-        Who_it(Func &func)
-            : func(std::addressof(func))
-        {
-            getwho();
-        }
-
-        const Who &operator*() const
-        {
-            return who;
-        }
-
-        const Who *operator->() const
-        {
-            return &**this;
-        }
-
-        Myt &operator++()
-        {
-            getwho();
-            return *this;
-        }
-
-        Myt operator++(int)
-        {
-            Myt tmp = *this;
-            ++*this;
-            return move(tmp);
-        }
-
-        bool equal(const Myt &right) const
-        {
-            return func == right.func;
-        }
-
-        void getwho()
-        {
-            if (func)
-                if (!(*func)(who))
-                    func = nullptr;
-        }
-
-        Func *func;
-        Who who;
-    };
-
-    template<class Func,
-            class Diff>
-        bool operator==(const Who_it<Func, Diff> &left, const Who_it<Func, Diff> &right)
-    {
-        return left.equal(right);
-    }
-
-    template<class Func,
-            class Diff>
-        bool operator!=(const Who_it<Func, Diff> &left, const Who_it<Func, Diff> &right)
-    {
-        return !(left == right);
-    }
 }
 
 void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
@@ -295,8 +214,6 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     time_t now = time(NULL);
     timeLastWhoCommand = now;
 
-    uint32 clientcount = 0;
-
     uint32 level_min, level_max, racemask, classmask, zones_count, str_count;
     uint32 zoneids[10];                                     // 10 is client limit
     string player_name, guild_name;
@@ -349,11 +266,8 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
                                 if (classmask == ~uint32())
                                     if (zones_count == 0)
                                     {
-                                        auto func = [](Who &)
-                                            {
-                                                return false;
-                                            };
-                                        auto msg = make_who_msg(Who_it<decltype(func)>(func), Who_it<decltype(func)>());
+                                        WhoListResults none;
+                                        auto msg = make_who_msg(none.begin(), none.end());
                                         SendPacket(&msg);
                                         return;
                                     }
@@ -370,124 +284,36 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     if (level_max >= MAX_LEVEL)
         level_max = STRONG_MAX_LEVEL;
 
-    uint32 team = _player->GetTeam();
-    uint32 security = GetSecurity();
-    bool allowTwoSideWhoList = sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST);
-    uint32 gmLevelInWhoList  = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    HashMapHolder<Player>::MapType::const_iterator itr = m.begin();
-    auto func = [&](Who &who) -> bool
-        {
-            // 49 is maximum player count sent to client - can be overridden
-            // through config, but is unstable
-            if (clientcount == sWorld->getIntConfig(CONFIG_MAX_WHO))
-                return false;
-            bool result = false;
-            for (; !result && itr != m.end(); ++itr)
-            {
-                if (AccountMgr::IsPlayerAccount(security))
-                {
-                    // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
-                    if (itr->second->GetTeam() != team && !allowTwoSideWhoList)
-                        continue;
-
-                    // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-                    if ((itr->second->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
-                        continue;
-                }
-
-                //do not process players which are not in world
-                if (!(itr->second->IsInWorld()))
-                    continue;
-
-                // check if target is globally visible for player
-                if (!(itr->second->IsVisibleGloballyFor(_player)))
-                    continue;
-
-                // check if target's level is in level range
-                uint8 lvl = itr->second->getLevel();
-                if (lvl < level_min || lvl > level_max)
-                    continue;
-
-                // check if class matches classmask
-                uint32 class_ = itr->second->getClass();
-                if (!(classmask & (1 << class_)))
-                    continue;
-
-                // check if race matches racemask
-                uint32 race = itr->second->getRace();
-                if (!(racemask & (1 << race)))
-                    continue;
-
-                uint32 pzoneid = itr->second->GetZoneId();
-                uint8 gender = itr->second->getGender();
-
-                bool z_show = true;
-                for (uint32 i = 0; i < zones_count; ++i)
-                {
-                    if (zoneids[i] == pzoneid)
-                    {
-                        z_show = true;
-                        break;
-                    }
-
-                    z_show = false;
-                }
-                if (!z_show)
-                    continue;
-
-                string pname = itr->second->GetName();
-                std::wstring wpname;
-                if (!Utf8toWStr(pname, wpname))
-                    continue;
-                wstrToLower(wpname);
-
-                if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-                    continue;
-
-                string gname = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-                std::wstring wgname;
-                if (!Utf8toWStr(gname, wgname))
-                    continue;
-                wstrToLower(wgname);
+    WhoListQuery query;
+    query.LevelMin = level_min;
+    query.LevelMax = level_max;
+    query.RaceMask = racemask;
+    query.ClassMask = classmask;
+    query.Zones.assign(zoneids, zoneids + zones_count);
+    query.PlayerName = move(wplayer_name);
+    query.GuildName = move(wguild_name);
+    for (uint32 i = 0; i < str_count; ++i)
+        if (!str[i].empty())
+            query.Strings.push_back(move(str[i]));
+    if (AccountMgr::IsPlayerAccount(GetSecurity()))
+    {
+        // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
+        if (!sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST))
+            query.Team = _player->GetTeamId();
 
-                if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-                    continue;
+        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+        query.MaxSecurity = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+    }
+    query.Locale = GetSessionDbcLocale();
+    // 49 is maximum player count sent to client - can be overridden
+    // through config, but is unstable
+    query.MaxResults = sWorld->getIntConfig(CONFIG_MAX_WHO);
+    query.Requester = _player;
 
-                string aname;
-                if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(itr->second->GetZoneId()))
-                    aname = areaEntry->area_name[GetSessionDbcLocale()];
+    WhoListResults results;
+    sWhoListIndex->Query(query, results);
 
-                bool s_show = true;
-                for (uint32 i = 0; i < str_count; ++i)
-                {
-                    if (!str[i].empty())
-                    {
-                        if (wgname.find(str[i]) != std::wstring::npos ||
-                            wpname.find(str[i]) != std::wstring::npos ||
-                            Utf8FitTo(aname, str[i]))
-                        {
-                            s_show = true;
-                            break;
-                        }
-                        s_show = false;
-                    }
-                }
-                if (!s_show)
-                    continue;
-                {
-                    Who tmp = {move(pname), move(gname), move(lvl), move(class_), move(race),
-                            move(gender), move(pzoneid)};
-                    who = move(tmp);
-                }
-                ++clientcount;
-                result = true;
-            }
-            return result;
-        };
-    WorldPacket data =
-        make_who_msg(Who_it<decltype(func)>(func), Who_it<decltype(func)>());
+    WorldPacket data = make_who_msg(results.begin(), results.end());
     SendPacket(&data);
     sLog->outDebug(LOG_FILTER_NETWORKIO, "WORLD: Send SMSG_WHO Message");
 }
@@ -17,7 +17,6 @@
  */
 
 #include "stdafx.hpp"
-#include <mutex>
 #include "Map.h"
 #include "Battleground.h"
 #include "CellImpl.h"
@@ -36,8 +35,9 @@
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "Vehicle.h"
-#include "vmap_mutex.hpp"
 #include "VMapFactory.h"
+#include <ace/Mem_Map.h>
+#include <type_traits>
 
 union u_map_magic
 {
@@ -123,14 +123,12 @@ bool Map::ExistVMap(uint32 mapid, int gx, int gy)
 {
     if (VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager())
     {
-        std::unique_lock<vmap_mutex_type> l(vmap_mutex());
         if (vmgr->isMapLoadingEnabled())
         {
             bool exists = vmgr->existsMap((sWorld->GetDataPath()+ "vmaps").c_str(),  mapid, gx, gy);
             if (!exists)
             {
                 std::string name = vmgr->getDirFileName(mapid, gx, gy);
-                l.unlock();
                 sLog->outError(LOG_FILTER_MAPS, "VMap file '%s' is missing or points to wrong version of vmap file. Redo vmaps with latest version of vmap_assembler.exe.", (sWorld->GetDataPath()+"vmaps/"+name).c_str());
                 return false;
             }
@@ -142,13 +140,8 @@ bool Map::ExistVMap(uint32 mapid, int gx, int gy)
 
 void Map::LoadVMap(int gx, int gy)
 {
-    int vmapLoadResult;
-    {
-        auto &m = *VMAP::VMapFactory::createOrGetVMapManager();
-        std::lock_guard<vmap_mutex_type> l(vmap_mutex());
-                                                                // x and y are swapped !!
-        vmapLoadResult = m.loadMap((sWorld->GetDataPath() + "vmaps").c_str(), GetId(), gx, gy);
-    }
+                                                            // x and y are swapped !!
+    int vmapLoadResult = VMAP::VMapFactory::createOrGetVMapManager()->loadMap((sWorld->GetDataPath() + "vmaps").c_str(), GetId(), gx, gy);
     switch (vmapLoadResult)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
@@ -339,7 +332,7 @@ template<>
 void Map::DeleteFromWorld(Player* player)
 {
     sObjectAccessor->RemoveObject(player);
-    sObjectAccessor->RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
+    player->RemoveFromObjectUpdate(); //TODO: I do not know why we need this, it should be removed in ~Object anyway
     delete player;
 }
 
@@ -540,6 +533,9 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 
 void Map::Update(const uint32 t_diff)
 {
+    uint64 phaseStart = getUSTime();
+    uint64 phaseEnd;
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -553,6 +549,13 @@ void Map::Update(const uint32 t_diff)
             session->Update(t_diff, updater);
         }
     }
+    phaseEnd = getUSTime();
+    _updateStats.sessions = uint32(phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+    _updateStats.regions.clear();
+    bool gridStats = sWorld->getBoolConfig(CONFIG_MAP_UPDATE_GRID_STATS);
+    uint64 objectStart = phaseStart;
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -562,6 +565,9 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    // all objects of one map are updated by the same thread: player and creature updates (AI, spells,
+    // scripts) reach into other cells and grids without any locking, so grid regions can't be split
+    // into concurrent tasks
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -571,10 +577,15 @@ void Map::Update(const uint32 t_diff)
         if (!player || !player->IsInWorld())
             continue;
 
+        uint32 region = gridStats ? GetUpdateRegion(player) : 0;
+
         // update players at tick
         player->Update(t_diff);
 
         VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+
+        if (gridStats)
+            AddRegionUpdateTime(region, objectStart);
     }
 
     // non-player active objects, increasing iterator in the loop in case of object removal
@@ -586,9 +597,21 @@ void Map::Update(const uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
+        uint32 region = gridStats ? GetUpdateRegion(obj) : 0;
+
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+
+        if (gridStats)
+            AddRegionUpdateTime(region, objectStart);
     }
 
+    if (gridStats)
+        MergeRegionUpdateTimes();
+
+    phaseEnd = getUSTime();
+    _updateStats.objects = uint32(phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
@@ -599,10 +622,104 @@ void Map::Update(const uint32 t_diff)
 
     MoveAllCreaturesInMoveList();
 
+    phaseEnd = getUSTime();
+    _updateStats.scripts = uint32(phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
+    phaseEnd = getUSTime();
+    _updateStats.relocation = uint32(phaseEnd - phaseStart);
+    phaseStart = phaseEnd;
+
     sScriptMgr->OnMapUpdate(this, t_diff);
+
+    SendObjectUpdates();
+
+    _updateStats.objectUpdates = uint32(getUSTime() - phaseStart);
+}
+
+void Map::AddUpdateObject(Object* obj)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+    _updateObjects.insert(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+    _updateObjects.erase(obj);
+}
+
+void Map::SendObjectUpdates()
+{
+    UpdateDataMapType update_players;
+
+    // take the queued objects and build their updates without the lock, so AddUpdateObject callers don't wait for the build
+    // objects queued while building are picked up by the next round
+    std::set<Object*> objects;
+    for (;;)
+    {
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            if (_updateObjects.empty())
+                break;
+
+            objects.swap(_updateObjects);
+        }
+
+        for (std::set<Object*>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
+        {
+            Object* obj = *itr;
+            ASSERT(obj && obj->IsInWorld());
+            obj->BuildUpdate(update_players);
+        }
+
+        objects.clear();
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
+}
+
+uint32 Map::GetUpdateRegion(WorldObject const* obj)
+{
+    GridCoord p = Trinity::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+    return p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord;
+}
+
+// one timer read per object: the end of one object update is the start of the next
+void Map::AddRegionUpdateTime(uint32 region, uint64& objectStart)
+{
+    uint64 objectEnd = getUSTime();
+    _updateStats.regions.push_back(std::make_pair(region, uint32(objectEnd - objectStart)));
+    objectStart = objectEnd;
+}
+
+void Map::MergeRegionUpdateTimes()
+{
+    std::vector<std::pair<uint32, uint32> >& regions = _updateStats.regions;
+    if (regions.empty())
+        return;
+
+    std::sort(regions.begin(), regions.end());
+
+    size_t last = 0;
+    for (size_t i = 1; i < regions.size(); ++i)
+    {
+        if (regions[i].first == regions[last].first)
+            regions[last].second += regions[i].second;
+        else
+            regions[++last] = regions[i];
+    }
+
+    regions.resize(last + 1);
 }
 
 struct ResetNotifier
@@ -1032,10 +1149,8 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
                 GridMaps[gx][gy]->unloadData();
                 delete GridMaps[gx][gy];
             }
-            auto &m = *VMAP::VMapFactory::createOrGetVMapManager();
-            std::lock_guard<vmap_mutex_type> l(vmap_mutex());
             // x and y are swapped
-            m.unloadMap(GetId(), gx, gy);
+            VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
@@ -1096,6 +1211,7 @@ GridMap::GridMap()
     _liquidEntry = NULL;
     _liquidFlags = NULL;
     _liquidMap  = NULL;
+    _mappedFile = NULL;
 }
 
 GridMap::~GridMap()
@@ -1108,57 +1224,64 @@ bool GridMap::loadData(char *filename)
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (ACE_OS::access(filename, R_OK) != 0)
         return true;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    _mappedFile = new ACE_Mem_Map();
+    if (_mappedFile->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) != 0)
     {
-        fclose(in);
+        sLog->outError(LOG_FILTER_MAPS, "Map file '%s' could not be mapped.", filename);
+        unloadData();
         return false;
     }
 
-    if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
+    // The mapping stays valid without the file, don't hold one descriptor per loaded grid
+    _mappedFile->close_handle();
+    _mappedFile->close_filemapping_handle();
+
+    map_fileheader const* header = mapData<map_fileheader>(0, 1);
+    if (!header)
+    {
+        unloadData();
+        return false;
+    }
+
+    if (header->mapMagic == MapMagic.asUInt && header->versionMagic == MapVersionMagic.asUInt)
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header->areaMapOffset && !loadAreaData(header->areaMapOffset, header->areaMapSize))
         {
             sLog->outError(LOG_FILTER_MAPS, "Error loading map area data\n");
-            fclose(in);
             return false;
         }
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header->heightMapOffset && !loadHeightData(header->heightMapOffset, header->heightMapSize))
         {
             sLog->outError(LOG_FILTER_MAPS, "Error loading map height data\n");
-            fclose(in);
             return false;
         }
         // loadup liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header->liquidMapOffset && !loadLiquidData(header->liquidMapOffset, header->liquidMapSize))
         {
             sLog->outError(LOG_FILTER_MAPS, "Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
-        fclose(in);
         return true;
     }
     sLog->outError(LOG_FILTER_MAPS, "Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
+    for (std::vector<uint8*>::const_iterator itr = _copiedData.begin(); itr != _copiedData.end(); ++itr)
+        delete[] *itr;
+    _copiedData.clear();
+
+    delete _mappedFile;                                     // unmaps the file
+    _mappedFile = NULL;
     _areaMap = NULL;
     m_V9 = NULL;
     m_V8 = NULL;
@@ -1168,61 +1291,78 @@ void GridMap::unloadData()
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+/**
+   Returns count elements of type T at offset in the mapped file, or NULL if
+   the file is too short. Data at a misaligned offset is copied.
+*/
+template<class T>
+T* GridMap::mapData(uint32 offset, uint32 count)
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    size_t size = size_t(count) * sizeof(T);
+    if (size_t(offset) + size > _mappedFile->size())
+        return NULL;
+
+    size_t const align = std::alignment_of<T>::value;
+    uint8* data = static_cast<uint8*>(_mappedFile->addr()) + offset;
+    if (reinterpret_cast<uintptr_t>(data) % align == 0)
+        return reinterpret_cast<T*>(data);
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    uint8* copy = new uint8[size + align];
+    _copiedData.push_back(copy);
+    uint8* aligned = copy + (align - reinterpret_cast<uintptr_t>(copy) % align) % align;
+    memcpy(aligned, data, size);
+    return reinterpret_cast<T*>(aligned);
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
+{
+    map_areaHeader const* header = mapData<map_areaHeader>(offset, 1);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
         return false;
 
-    _gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
+    _gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16 [16*16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        _areaMap = mapData<uint16>(offset + sizeof(map_areaHeader), 16*16);
+        if (!_areaMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
-    map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    map_heightHeader const* header = mapData<map_heightHeader>(offset, 1);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
         return false;
 
-    _gridHeight = header.gridHeight;
-    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    offset += sizeof(map_heightHeader);
+    _gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
     {
-        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            m_uint16_V9 = mapData<uint16>(offset, 129*129);
+            m_uint16_V8 = mapData<uint16>(offset + 129*129*sizeof(uint16), 128*128);
+            if (!m_uint16_V9 || !m_uint16_V8)
                 return false;
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
-        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            m_uint8_V9 = mapData<uint8>(offset, 129*129);
+            m_uint8_V8 = mapData<uint8>(offset + 129*129*sizeof(uint8), 128*128);
+            if (!m_uint8_V9 || !m_uint8_V8)
                 return false;
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            m_V9 = mapData<float>(offset, 129*129);
+            m_V8 = mapData<float>(offset + 129*129*sizeof(float), 128*128);
+            if (!m_V9 || !m_V8)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -1232,35 +1372,36 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(uint32 offset, uint32 /*size*/)
 {
-    map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    map_liquidHeader const* header = mapData<map_liquidHeader>(offset, 1);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
         return false;
 
-    _liquidType   = header.liquidType;
-    _liquidOffX  = header.offsetX;
-    _liquidOffY  = header.offsetY;
-    _liquidWidth = header.width;
-    _liquidHeight = header.height;
-    _liquidLevel  = header.liquidLevel;
+    offset += sizeof(map_liquidHeader);
+    _liquidType   = header->liquidType;
+    _liquidOffX  = header->offsetX;
+    _liquidOffY  = header->offsetY;
+    _liquidWidth = header->width;
+    _liquidHeight = header->height;
+    _liquidLevel  = header->liquidLevel;
 
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        _liquidEntry = mapData<uint16>(offset, 16*16);
+        if (!_liquidEntry)
             return false;
 
-        _liquidFlags = new uint8[16*16];
-        if (fread(_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        _liquidFlags = mapData<uint8>(offset + 16*16*sizeof(uint16), 16*16);
+        if (!_liquidFlags)
             return false;
+
+        offset += 16*16*sizeof(uint16) + 16*16*sizeof(uint8);
     }
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        _liquidMap = mapData<float>(offset, uint32(_liquidWidth) * uint32(_liquidHeight));
+        if (!_liquidMap)
             return false;
     }
     return true;
@@ -1283,11 +1424,9 @@ float GridMap::getHeightFromFlat(float /*x*/, float /*y*/) const
     return _gridHeight;
 }
 
-float GridMap::getHeightFromFloat(float x, float y) const
+template<class T, class V>
+inline float GridMap::sampleHeight(T const* V9, T const* V8, float x, float y)
 {
-    if (!m_V8 || !m_V9)
-        return _gridHeight;
-
     x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
     y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
 
@@ -1313,16 +1452,20 @@ float GridMap::getHeightFromFloat(float x, float y) const
     // 2 - solve linear equation from triangle points
     // Calculate coefficients for solve h = a*x + b*y + c
 
-    float a, b, c;
+    T const* V9_h1_ptr = &V9[x_int*129 + y_int];
+    V h1 = V9_h1_ptr[  0];
+    V h2 = V9_h1_ptr[129];
+    V h3 = V9_h1_ptr[  1];
+    V h4 = V9_h1_ptr[130];
+    V h5 = 2 * V(V8[x_int*128 + y_int]);
+
+    V a, b, c;
     // Select triangle:
     if (x+y < 1)
     {
         if (x > y)
         {
             // 1 triangle (h1, h2, h5 points)
-            float h1 = m_V9[(x_int)*129 + y_int];
-            float h2 = m_V9[(x_int+1)*129 + y_int];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
             a = h2-h1;
             b = h5-h1-h2;
             c = h1;
@@ -1330,9 +1473,6 @@ float GridMap::getHeightFromFloat(float x, float y) const
         else
         {
             // 2 triangle (h1, h3, h5 points)
-            float h1 = m_V9[x_int*129 + y_int  ];
-            float h3 = m_V9[x_int*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
             a = h5 - h1 - h3;
             b = h3 - h1;
             c = h1;
@@ -1343,9 +1483,6 @@ float GridMap::getHeightFromFloat(float x, float y) const
         if (x > y)
         {
             // 3 triangle (h2, h4, h5 points)
-            float h2 = m_V9[(x_int+1)*129 + y_int  ];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
             a = h2 + h4 - h5;
             b = h4 - h2;
             c = h5 - h4;
@@ -1353,9 +1490,6 @@ float GridMap::getHeightFromFloat(float x, float y) const
         else
         {
             // 4 triangle (h3, h4, h5 points)
-            float h3 = m_V9[(x_int)*129 + y_int+1];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
             a = h4 - h3;
             b = h3 + h4 - h5;
             c = h5 - h4;
@@ -1365,71 +1499,20 @@ float GridMap::getHeightFromFloat(float x, float y) const
     return a * x + b * y + c;
 }
 
-float GridMap::getHeightFromUint8(float x, float y) const
+float GridMap::getHeightFromFloat(float x, float y) const
 {
-    if (!m_uint8_V8 || !m_uint8_V9)
+    if (!m_V8 || !m_V9)
         return _gridHeight;
 
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
+    return sampleHeight<float, float>(m_V9, m_V8, x, y);
+}
 
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
+float GridMap::getHeightFromUint8(float x, float y) const
+{
+    if (!m_uint8_V8 || !m_uint8_V9)
+        return _gridHeight;
 
-    int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
+    return sampleHeight<uint8, int32>(m_uint8_V9, m_uint8_V8, x, y)*_gridIntHeightMultiplier + _gridHeight;
 }
 
 float GridMap::getHeightFromUint16(float x, float y) const
@@ -1437,66 +1520,33 @@ float GridMap::getHeightFromUint16(float x, float y) const
     if (!m_uint16_V8 || !m_uint16_V9)
         return _gridHeight;
 
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
+    return sampleHeight<uint16, int32>(m_uint16_V9, m_uint16_V8, x, y)*_gridIntHeightMultiplier + _gridHeight;
+}
 
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
+template<class T>
+void GridMap::sampleHeights(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const
+{
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = sampleHeight<T, int32>(V9, V8, x[i], y[i]);
 
-    int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
+    // scaling done as a separate pass the compiler can vectorize
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = heights[i]*_gridIntHeightMultiplier + _gridHeight;
+}
+
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    if (_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+        sampleHeights<uint16>(m_uint16_V9, m_uint16_V8, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+        sampleHeights<uint8>(m_uint8_V9, m_uint8_V8, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
     {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = sampleHeight<float, float>(m_V9, m_V8, x[i], y[i]);
     }
     else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
+        std::fill(heights, heights + count, _gridHeight);
 }
 
 float GridMap::getLiquidLevel(float x, float y) const
@@ -1659,21 +1709,60 @@ float Map::GetWaterOrGroundLevel(float x, float y, float z, float* ground /*= NU
 
 float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
 {
-    // find raw .map surface under Z coordinates
-    float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
+    float gridHeight = VMAP_INVALID_HEIGHT_VALUE;
     if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
+        gridHeight = gmap->getHeight(x, y);
+
+    return SelectHeight(gridHeight, x, y, z, checkVMap, maxSearchDist);
+}
+
+void Map::GetHeights(uint32 phasemask, float const* x, float const* y, float const* z, float* heights, uint32 count, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    GetGridHeights(x, y, heights, count);
+
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = GetHeightFromGrid(phasemask, heights[i], x[i], y[i], z[i], vmap, maxSearchDist);
+}
+
+void Map::GetGridHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    // sample runs of points in the same grid at once
+    for (uint32 i = 0; i < count;)
     {
-        float gridHeight = gmap->getHeight(x, y);
-        // look from a bit higher pos to find the floor, ignore under surface case
-        if (z + 2.0f > gridHeight)
-            mapHeight = gridHeight;
+        GridMap* gmap = const_cast<Map*>(this)->GetGrid(x[i], y[i]);
+        int gx = int(32 - x[i] / SIZE_OF_GRIDS);
+        int gy = int(32 - y[i] / SIZE_OF_GRIDS);
+
+        uint32 end = i + 1;
+        while (end < count && int(32 - x[end] / SIZE_OF_GRIDS) == gx && int(32 - y[end] / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (gmap)
+            gmap->getHeights(x + i, y + i, heights + i, end - i);
+        else
+            std::fill(heights + i, heights + end, VMAP_INVALID_HEIGHT_VALUE);
+
+        i = end;
     }
+}
+
+float Map::GetHeightFromGrid(uint32 phasemask, float gridHeight, float x, float y, float z, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    return std::max<float>(SelectHeight(gridHeight, x, y, z, vmap, maxSearchDist), _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask));
+}
+
+float Map::SelectHeight(float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist) const
+{
+    // find raw .map surface under Z coordinates
+    float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
+    // look from a bit higher pos to find the floor, ignore under surface case
+    if (z + 2.0f > gridHeight)
+        mapHeight = gridHeight;
 
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
     if (checkVMap)
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-        std::lock_guard<vmap_mutex_type> l(vmap_mutex());
         if (vmgr->isHeightCalcEnabled())
             vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);   // look from a bit higher pos to find the floor
     }
@@ -1747,21 +1836,17 @@ bool Map::GetAreaInfo(float x, float y, float z, uint32 &flags, int32 &adtId, in
 {
     float vmap_z = z;
     VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (vmgr->getAreaInfo(GetId(), x, y, vmap_z, flags, adtId, rootId, groupId))
     {
-        std::unique_lock<vmap_mutex_type> l(vmap_mutex());
-        if (vmgr->getAreaInfo(GetId(), x, y, vmap_z, flags, adtId, rootId, groupId))
+        // check if there's terrain between player height and object height
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
         {
-            l.unlock();
-            // check if there's terrain between player height and object height
-            if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
-            {
-                float _mapheight = gmap->getHeight(x, y);
-                // z + 2.0f condition taken from GetHeight(), not sure if it's such a great choice...
-                if (z + 2.0f > _mapheight &&  _mapheight > vmap_z)
-                    return false;
-            }
-            return true;
+            float _mapheight = gmap->getHeight(x, y);
+            // z + 2.0f condition taken from GetHeight(), not sure if it's such a great choice...
+            if (z + 2.0f > _mapheight &&  _mapheight > vmap_z)
+                return false;
         }
+        return true;
     }
     return false;
 }
@@ -1805,6 +1890,15 @@ uint16 Map::GetAreaFlag(float x, float y, float z, bool *isOutdoors) const
     return areaflag;
  }
 
+uint64 Map::GetAreaCacheKey(float x, float y, float z)
+{
+    // 21 bits per axis is enough for +-1M cells, the highest bit stays clear so no key equals AREA_CACHE_INVALID_KEY
+    uint64 cellX = uint32(int32(floor(x / AREA_CACHE_CELL_SIZE))) & 0x1FFFFF;
+    uint64 cellY = uint32(int32(floor(y / AREA_CACHE_CELL_SIZE))) & 0x1FFFFF;
+    uint64 cellZ = uint32(int32(floor(z / AREA_CACHE_CELL_HEIGHT))) & 0x1FFFFF;
+    return (cellX << 42) | (cellY << 21) | cellZ;
+}
+
 uint8 Map::GetTerrainType(float x, float y) const
 {
     if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
@@ -1820,64 +1914,60 @@ ZLiquidStatus Map::getLiquidStatus(float x, float y, float z, uint8 ReqLiquidTyp
     float liquid_level = INVALID_HEIGHT;
     float ground_level = INVALID_HEIGHT;
     uint32 liquid_type = 0;
+    if (vmgr->GetLiquidLevel(GetId(), x, y, z, ReqLiquidType, liquid_level, ground_level, liquid_type))
     {
-        std::unique_lock<vmap_mutex_type> l(vmap_mutex());
-        if (vmgr->GetLiquidLevel(GetId(), x, y, z, ReqLiquidType, liquid_level, ground_level, liquid_type))
+        sLog->outDebug(LOG_FILTER_MAPS, "getLiquidStatus(): vmap liquid level: %f ground: %f type: %u", liquid_level, ground_level, liquid_type);
+        // Check water level and ground level
+        if (liquid_level > ground_level && z > ground_level - 2)
         {
-            l.unlock();
-            sLog->outDebug(LOG_FILTER_MAPS, "getLiquidStatus(): vmap liquid level: %f ground: %f type: %u", liquid_level, ground_level, liquid_type);
-            // Check water level and ground level
-            if (liquid_level > ground_level && z > ground_level - 2)
+            // All ok in water -> store data
+            if (data)
             {
-                // All ok in water -> store data
-                if (data)
-                {
-                    // hardcoded in client like this
-                    if (GetId() == 530 && liquid_type == 2)
-                        liquid_type = 15;
+                // hardcoded in client like this
+                if (GetId() == 530 && liquid_type == 2)
+                    liquid_type = 15;
 
-                    uint32 liquidFlagType = 0;
-                    if (LiquidTypeEntry const* liq = sLiquidTypeStore.LookupEntry(liquid_type))
-                        liquidFlagType = liq->Type;
+                uint32 liquidFlagType = 0;
+                if (LiquidTypeEntry const* liq = sLiquidTypeStore.LookupEntry(liquid_type))
+                    liquidFlagType = liq->Type;
 
-                    if (liquid_type && liquid_type < 21)
+                if (liquid_type && liquid_type < 21)
+                {
+                    if (AreaTableEntry const* area = GetAreaEntryByAreaFlagAndMap(GetAreaFlag(x, y, z), GetId()))
                     {
-                        if (AreaTableEntry const* area = GetAreaEntryByAreaFlagAndMap(GetAreaFlag(x, y, z), GetId()))
+                        uint32 overrideLiquid = area->LiquidTypeOverride[liquidFlagType];
+                        if (!overrideLiquid && area->zone)
                         {
-                            uint32 overrideLiquid = area->LiquidTypeOverride[liquidFlagType];
-                            if (!overrideLiquid && area->zone)
-                            {
-                                area = GetAreaEntryByAreaID(area->zone);
-                                if (area)
-                                    overrideLiquid = area->LiquidTypeOverride[liquidFlagType];
-                            }
-
-                            if (LiquidTypeEntry const* liq = sLiquidTypeStore.LookupEntry(overrideLiquid))
-                            {
-                                liquid_type = overrideLiquid;
-                                liquidFlagType = liq->Type;
-                            }
+                            area = GetAreaEntryByAreaID(area->zone);
+                            if (area)
+                                overrideLiquid = area->LiquidTypeOverride[liquidFlagType];
                         }
-                    }
-
-                    data->level = liquid_level;
-                    data->depth_level = ground_level;
 
-                    data->entry = liquid_type;
-                    data->type_flags = 1 << liquidFlagType;
+                        if (LiquidTypeEntry const* liq = sLiquidTypeStore.LookupEntry(overrideLiquid))
+                        {
+                            liquid_type = overrideLiquid;
+                            liquidFlagType = liq->Type;
+                        }
+                    }
                 }
 
-                float delta = liquid_level - z;
+                data->level = liquid_level;
+                data->depth_level = ground_level;
 
-                // Get position delta
-                if (delta > 2.0f)                   // Under water
-                    return LIQUID_MAP_UNDER_WATER;
-                if (delta > 0.0f)                   // In water
-                    return LIQUID_MAP_IN_WATER;
-                if (delta > -0.1f)                   // Walk on water
-                    return LIQUID_MAP_WATER_WALK;
-                result = LIQUID_MAP_ABOVE_WATER;
+                data->entry = liquid_type;
+                data->type_flags = 1 << liquidFlagType;
             }
+
+            float delta = liquid_level - z;
+
+            // Get position delta
+            if (delta > 2.0f)                   // Under water
+                return LIQUID_MAP_UNDER_WATER;
+            if (delta > 0.0f)                   // In water
+                return LIQUID_MAP_IN_WATER;
+            if (delta > -0.1f)                   // Walk on water
+                return LIQUID_MAP_WATER_WALK;
+            result = LIQUID_MAP_ABOVE_WATER;
         }
     }
 
@@ -2807,6 +2897,15 @@ void BattlegroundMap::RemovePlayerFromMap(Player* player, bool remove)
     Map::RemovePlayerFromMap(player, remove);
 }
 
+void BattlegroundMap::Update(const uint32 t_diff)
+{
+    Map::Update(t_diff);
+
+    // battleground logic runs with its map, what it hands back to the queues is done by BattlegroundMgr::Update
+    if (m_bg)
+        m_bg->Update(t_diff);
+}
+
 void BattlegroundMap::SetUnload()
 {
     m_unloadTimer = MIN_UNLOAD_DELAY;
@@ -35,6 +35,7 @@
 
 #include <bitset>
 #include <list>
+#include <set>
 
 class Unit;
 class WorldPacket;
@@ -52,6 +53,7 @@ struct Position;
 class Battleground;
 class MapInstanced;
 class InstanceMap;
+class ACE_Mem_Map;
 namespace Trinity { struct ObjectUpdater; }
 
 typedef uint32 WMO_id;
@@ -176,10 +178,15 @@ class GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
+    // The file is mapped read only, so its pages are shared through the page cache
+    ACE_Mem_Map* _mappedFile;
+    std::vector<uint8*> _copiedData;                        // arrays at misaligned file offsets
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    template<class T>
+    T* mapData(uint32 offset, uint32 count);
+    bool loadAreaData(uint32 offset, uint32 size);
+    bool loadHeightData(uint32 offset, uint32 size);
+    bool loadLiquidData(uint32 offset, uint32 size);
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -189,6 +196,12 @@ class GridMap
     float getHeightFromUint8(float x, float y) const;
     float getHeightFromFlat(float x, float y) const;
 
+    // height of the V9/V8 triangle below x, y, in units of the stored values
+    template<class T, class V>
+    static float sampleHeight(T const* V9, T const* V8, float x, float y);
+    template<class T>
+    void sampleHeights(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const;
+
 public:
     GridMap();
     ~GridMap();
@@ -197,6 +210,8 @@ public:
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
+    // same as getHeight for many points of this grid, selecting the height format once
+    void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
     float getLiquidLevel(float x, float y) const;
     uint8 getTerrainType(float x, float y) const;
     ZLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, LiquidData* data = 0);
@@ -231,6 +246,9 @@ enum LevelRequirementVsMode
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
+#define AREA_CACHE_CELL_SIZE       1.0f                     // horizontal size of a cached area lookup cell
+#define AREA_CACHE_CELL_HEIGHT     2.0f                     // vertical size of a cached area lookup cell
+#define AREA_CACHE_INVALID_KEY    UI64LIT(0xFFFFFFFFFFFFFFFF)
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
@@ -243,6 +261,22 @@ struct instance_difficulty
 
 instance_difficulty make_instance_difficulty(const MapEntry &map_entry, Difficulty difficulty);
 
+// timings of the last Map::Update, in microseconds
+struct MapUpdateStats
+{
+    MapUpdateStats() : total(0), sessions(0), objects(0), scripts(0), relocation(0), objectUpdates(0) {}
+
+    uint32 total;                                           // whole (virtual) Update, measured by MapUpdater
+    uint32 sessions;
+    uint32 objects;
+    uint32 scripts;                                         // map scripts and creature move list
+    uint32 relocation;
+    uint32 objectUpdates;                                   // building and sending SMSG_UPDATE_OBJECT for changed values
+    // object updates by grid of the player/active object driving them, sorted by grid id
+    // only filled with MapUpdate.GridStats enabled
+    std::vector<std::pair<uint32 /*grid id*/, uint32> > regions;
+};
+
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -273,6 +307,16 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        MapUpdateStats const& GetUpdateStats() const { return _updateStats; }
+        void SetUpdateTotalTime(uint32 total) { _updateStats.total = total; }
+        // key of MapUpdateStats::regions
+        static uint32 GetUpdateRegion(WorldObject const* obj);
+
+        // objects with changed values, flushed by the map's own update task
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
+        void SendObjectUpdates();
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -326,6 +370,9 @@ class Map : public GridRefManager<NGridType>
 
         bool IsOutdoors(float x, float y, float z) const;
 
+        // cell of a position for the per-object area cache, see WorldObject::UpdateAreaCache
+        static uint64 GetAreaCacheKey(float x, float y, float z);
+
         uint8 GetTerrainType(float x, float y) const;
         float GetWaterLevel(float x, float y) const;
         bool IsInWater(float x, float y, float z, LiquidData* data = 0) const;
@@ -452,6 +499,11 @@ class Map : public GridRefManager<NGridType>
         const InstanceMap* ToInstanceMap() const { if (IsDungeon())  return (const InstanceMap*)((InstanceMap*)this); else return NULL;  }
         float GetWaterOrGroundLevel(float x, float y, float z, float* ground = NULL, bool swim = false) const;
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // GetHeight for many points, .map heights of points in the same grid are sampled together
+        void GetHeights(uint32 phasemask, float const* x, float const* y, float const* z, float* heights, uint32 count, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // .map heights only, to be completed with GetHeightFromGrid when the points are checked one by one
+        void GetGridHeights(float const* x, float const* y, float* heights, uint32 count) const;
+        float GetHeightFromGrid(uint32 phasemask, float gridHeight, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
         void Balance() { _dynamicTree.balance(); }
         void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
@@ -499,6 +551,7 @@ class Map : public GridRefManager<NGridType>
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
         GridMap* GetGrid(float x, float y);
+        float SelectHeight(float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist) const;
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -627,6 +680,14 @@ class Map : public GridRefManager<NGridType>
         UNORDERED_MAP<uint32 /*dbGUID*/, time_t> _creatureRespawnTimes;
         UNORDERED_MAP<uint32 /*dbGUID*/, time_t> _goRespawnTimes;
         instance_difficulty instance_difficulty_;
+
+        void AddRegionUpdateTime(uint32 region, uint64& objectStart);
+        void MergeRegionUpdateTimes();
+
+        MapUpdateStats _updateStats;
+
+        std::set<Object*> _updateObjects;
+        ACE_Thread_Mutex _updateObjectsLock;
 };
 
 enum InstanceResetMethod
@@ -676,6 +737,7 @@ class BattlegroundMap : public Map
 
         bool AddPlayerToMap(Player*);
         void RemovePlayerFromMap(Player*, bool);
+        void Update(const uint32);
         bool CanEnter(Player* player);
         void SetUnload();
         //void UnloadAll(bool pForce);
@@ -17,13 +17,11 @@
  */
 
 #include "stdafx.hpp"
-#include <mutex>
 #include "MapInstanced.h"
 #include "ObjectMgr.h"
 #include "MapManager.h"
 #include "Battleground.h"
 #include "VMapFactory.h"
-#include "vmap_mutex.hpp"
 #include "InstanceSaveMgr.h"
 #include "World.h"
 #include "Group.h"
@@ -263,11 +261,7 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator &itr)
     // should only unload VMaps if this is the last instance and grid unloading is enabled
     if (m_InstancedMaps.size() <= 1 && sWorld->getBoolConfig(CONFIG_GRID_UNLOAD))
     {
-        {
-            auto &m = *VMAP::VMapFactory::createOrGetVMapManager();
-            std::lock_guard<vmap_mutex_type> l(vmap_mutex());
-            m.unloadMap(itr->second->GetId());
-        }
+        VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(itr->second->GetId());
         // in that case, unload grids of the base map, too
         // so in the next map creation, (EnsureGridCreated actually) VMaps will be reloaded
         Map::UnloadAll();
@@ -291,6 +291,18 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    // values changed after a map's own update (delayed updates, removals, grid unloads) are sent in this tick too
+    for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    {
+        Map* map = iter->second;
+        map->SendObjectUpdates();
+        if (!map->Instanceable())
+            continue;
+        MapInstanced::InstancedMaps &instances = ((MapInstanced*)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            mitr->second->SendObjectUpdates();
+    }
+
     sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
     for (TransportSet::iterator itr = m_Transports.begin(); itr != m_Transports.end(); ++itr)
         (*itr)->Update(uint32(i_timer.GetCurrent()));
@@ -380,6 +392,32 @@ uint32 MapManager::GetNumPlayersInInstances()
     return ret;
 }
 
+static bool MapUpdateTimeGreater(Map const* a, Map const* b)
+{
+    return a->GetUpdateStats().total > b->GetUpdateStats().total;
+}
+
+void MapManager::GetSlowestMaps(std::vector<Map*>& maps, uint32 count)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, Lock);
+
+    maps.clear();
+    for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+    {
+        Map* map = itr->second;
+        maps.push_back(map);
+        if (!map->Instanceable())
+            continue;
+        MapInstanced::InstancedMaps &instances = ((MapInstanced*)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            maps.push_back(mitr->second);
+    }
+
+    std::sort(maps.begin(), maps.end(), MapUpdateTimeGreater);
+    if (maps.size() > count)
+        maps.resize(count);
+}
+
 void MapManager::InitInstanceIds()
 {
     _nextInstanceId = 1;
@@ -136,6 +136,8 @@ class MapManager
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        // maps (instances included) with the longest last update, slowest first
+        void GetSlowestMaps(std::vector<Map*>& maps, uint32 count);
 
         // Instance ID management
         void InitInstanceIds();
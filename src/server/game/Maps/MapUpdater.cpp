@@ -1,65 +1,44 @@
 #include "stdafx.hpp"
 #include "MapUpdater.h"
-#include "DelayExecutor.h"
 #include "Map.h"
-#include "DatabaseEnv.h"
+#include "Timer.h"
 
 #include <ace/Guard_T.h>
-#include <ace/Method_Request.h>
+#include <ace/Thread.h>
 
-class WDBThreadStartReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadStartReq1()
-        {
-        }
-
-        virtual int call()
-        {
-            return 0;
-        }
-};
-
-class WDBThreadEndReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadEndReq1()
-        {
-        }
-
-        virtual int call()
-        {
-            return 0;
-        }
-};
-
-class MapUpdateRequest : public ACE_Method_Request
+class MapUpdateRequest
 {
     private:
 
         Map& m_map;
         MapUpdater& m_updater;
         ACE_UINT32 m_diff;
+        uint64 m_cost;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
             : m_map(m), m_updater(u), m_diff(d)
         {
+            // last update duration is the best guess for this one, never 0 so empty maps still count
+            m_cost = uint64(m.GetUpdateStats().total) + 1;
         }
 
-        virtual int call()
+        uint64 GetCost() const { return m_cost; }
+
+        void call(size_t worker)
         {
-            m_map.Update (m_diff);
-            m_updater.update_finished();
-            return 0;
+            uint64 start = getUSTime();
+            m_map.Update(m_diff);
+            uint32 duration = uint32(getUSTime() - start);
+            m_map.SetUpdateTotalTime(duration);
+            m_updater.update_finished(worker, duration);
         }
 };
 
 MapUpdater::MapUpdater():
-m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
+m_mutex(), m_condition(m_mutex), m_workCondition(m_mutex), pending_requests(0), queued_requests(0),
+m_nextWorker(0), m_activated(false), m_shutdown(false)
 {
 }
 
@@ -70,14 +49,50 @@ MapUpdater::~MapUpdater()
 
 int MapUpdater::activate(size_t num_threads)
 {
-    return m_executor.start((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
+    if (m_activated || num_threads < 1)
+        return -1;
+
+    for (size_t i = 0; i < num_threads; ++i)
+        m_workers.push_back(new Worker());
+
+    m_nextWorker = 0;
+    m_shutdown = false;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE, int(num_threads)) == -1)
+    {
+        destroy_workers();
+        return -1;
+    }
+
+    m_lastTickStats.assign(num_threads, MapUpdaterWorkerStats());
+    m_activated = true;
+    return 0;
 }
 
 int MapUpdater::deactivate()
 {
+    if (!m_activated)
+        return -1;
+
     wait();
 
-    return m_executor.deactivate();
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_activated = false;
+        m_shutdown = true;
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+    destroy_workers();
+    return 0;
+}
+
+void MapUpdater::destroy_workers()
+{
+    for (std::vector<Worker*>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+        delete *itr;
+    m_workers.clear();
 }
 
 int MapUpdater::wait()
@@ -87,21 +102,143 @@ int MapUpdater::wait()
     while (pending_requests > 0)
         m_condition.wait();
 
+    // all threads are idle now, publish and restart the per tick counters
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_lastTickStats[i] = m_workers[i]->stats;
+        m_workers[i]->stats = MapUpdaterWorkerStats();
+    }
+
     return 0;
 }
 
+// m_mutex must be held
+size_t MapUpdater::select_worker()
+{
+    // called from one of our threads (MapInstanced scheduling its instances): keep the work local,
+    // idle threads will steal it
+    ACE_thread_t self = ACE_Thread::self();
+    for (size_t i = 0; i < m_workers.size(); ++i)
+        if (ACE_OS::thr_equal(m_workers[i]->thread, self))
+            return i;
+
+    size_t best = 0;
+    uint64 bestCost = 0;
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        uint64 cost;
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_workers[i]->lock);
+            cost = m_workers[i]->queuedCost;
+        }
+
+        if (!i || cost < bestCost)
+        {
+            best = i;
+            bestCost = cost;
+        }
+    }
+
+    return best;
+}
+
+void MapUpdater::enqueue(size_t worker, MapUpdateRequest* request)
+{
+    Worker& w = *m_workers[worker];
+    TRINITY_GUARD(ACE_Thread_Mutex, w.lock);
+
+    std::deque<MapUpdateRequest*>::iterator itr = w.queue.begin();
+    while (itr != w.queue.end() && (*itr)->GetCost() >= request->GetCost())
+        ++itr;
+
+    w.queue.insert(itr, request);
+    w.queuedCost += request->GetCost();
+}
+
 int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 {
+    if (!m_activated)
+        return -1;
+
+    MapUpdateRequest* request = new MapUpdateRequest(map, *this, diff);
+
+    size_t worker;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        ++pending_requests;
+        worker = select_worker();
+    }
+
+    enqueue(worker, request);
+
     TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    ++queued_requests;
+    m_workCondition.signal();
+
+    return 0;
+}
+
+MapUpdateRequest* MapUpdater::pop_request(size_t worker)
+{
+    Worker& w = *m_workers[worker];
+    TRINITY_GUARD(ACE_Thread_Mutex, w.lock);
+
+    if (w.queue.empty())
+        return NULL;
 
-    ++pending_requests;
+    MapUpdateRequest* request = w.queue.front();
+    w.queue.pop_front();
+    w.queuedCost -= request->GetCost();
+    return request;
+}
 
-    if (m_executor.execute(new MapUpdateRequest(map, *this, diff)) == -1)
+MapUpdateRequest* MapUpdater::take_request(size_t worker)
+{
+    MapUpdateRequest* request = pop_request(worker);
+    if (!request)
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
+        for (size_t i = 1; i < m_workers.size() && !request; ++i)
+            request = pop_request((worker + i) % m_workers.size());
 
-        --pending_requests;
-        return -1;
+        if (request)
+            ++m_workers[worker]->stats.steals;
+    }
+
+    if (request)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        --queued_requests;
+    }
+
+    return request;
+}
+
+int MapUpdater::svc()
+{
+    size_t worker;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        worker = m_nextWorker++;
+        m_workers[worker]->thread = ACE_Thread::self();
+    }
+
+    for (;;)
+    {
+        if (MapUpdateRequest* request = take_request(worker))
+        {
+            request->call(worker);
+            delete request;
+            continue;
+        }
+
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+        if (m_shutdown)
+            break;
+
+        // a request may be counted but still in the middle of being stolen, look again
+        if (!queued_requests)
+            m_workCondition.wait();
     }
 
     return 0;
@@ -109,11 +246,15 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 
 bool MapUpdater::activated()
 {
-    return m_executor.activated();
+    return m_activated;
 }
 
-void MapUpdater::update_finished()
+void MapUpdater::update_finished(size_t worker, uint32 duration)
 {
+    MapUpdaterWorkerStats& stats = m_workers[worker]->stats;
+    stats.busyTime += duration;
+    ++stats.updates;
+
     TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
 
     if (pending_requests == 0)
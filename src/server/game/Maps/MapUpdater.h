@@ -3,12 +3,38 @@
 
 #include <ace/Thread_Mutex.h>
 #include <ace/Condition_Thread_Mutex.h>
+#include <ace/Task.h>
 
-#include "DelayExecutor.h"
+#include <deque>
+#include <vector>
+
+#include "Define.h"
 
 class Map;
+class MapUpdateRequest;
+
+// counters of one update thread for the last finished tick, times in microseconds
+struct MapUpdaterWorkerStats
+{
+    MapUpdaterWorkerStats() : busyTime(0), updates(0), steals(0) {}
+
+    uint32 busyTime;
+    uint32 updates;
+    uint32 steals;                                          // updates taken from another thread's queue
+};
 
-class MapUpdater
+typedef std::vector<MapUpdaterWorkerStats> MapUpdaterStats;
+
+/*
+    Every update thread owns a queue of map updates sorted by the expected cost
+    (the duration of the map's previous update), most expensive first. Maps
+    scheduled from the world thread go to the thread with the least queued
+    cost, maps scheduled from an update thread (instances of a MapInstanced)
+    go to that thread's own queue. A thread that runs out of work steals the
+    most expensive waiting update from the other queues, so one long update
+    (a crowded continent) never leaves small instances queued behind it.
+*/
+class MapUpdater : protected ACE_Task_Base
 {
     public:
 
@@ -27,14 +53,41 @@ class MapUpdater
 
         bool activated();
 
+        // only valid between ticks, refreshed when wait() returns
+        MapUpdaterStats const& GetLastTickStats() const { return m_lastTickStats; }
+
+        virtual int svc();
+
     private:
 
-        DelayExecutor m_executor;
+        struct Worker
+        {
+            Worker() : queuedCost(0), thread(0) {}
+
+            ACE_Thread_Mutex lock;
+            std::deque<MapUpdateRequest*> queue;
+            uint64 queuedCost;
+            ACE_thread_t thread;
+            MapUpdaterWorkerStats stats;
+        };
+
+        std::vector<Worker*> m_workers;
         ACE_Thread_Mutex m_mutex;
-        ACE_Condition_Thread_Mutex m_condition;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when an update finished
+        ACE_Condition_Thread_Mutex m_workCondition;         // signaled when an update was queued
         size_t pending_requests;
+        size_t queued_requests;
+        size_t m_nextWorker;
+        bool m_activated;
+        bool m_shutdown;
+        MapUpdaterStats m_lastTickStats;
 
-        void update_finished();
+        void update_finished(size_t worker, uint32 duration);
+        size_t select_worker();
+        void enqueue(size_t worker, MapUpdateRequest* request);
+        MapUpdateRequest* take_request(size_t worker);
+        MapUpdateRequest* pop_request(size_t worker);
+        void destroy_workers();
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
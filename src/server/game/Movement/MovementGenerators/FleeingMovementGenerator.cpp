@@ -174,9 +174,13 @@ bool FleeingMovementGenerator<T>::_getPoint(T &owner, float &x, float &y, float
 
             if (!(new_z - z) || distance / fabs(new_z - z) > 1.0f)
             {
-                float new_z_left = _map->GetHeight(owner.GetPhaseMask(), temp_x + 1.0f* std::cos(angle+static_cast<float>(M_PI/2)),temp_y + 1.0f* std::sin(angle+static_cast<float>(M_PI/2)),z,true);
-                float new_z_right = _map->GetHeight(owner.GetPhaseMask(), temp_x + 1.0f* std::cos(angle-static_cast<float>(M_PI/2)),temp_y + 1.0f* std::sin(angle-static_cast<float>(M_PI/2)),z,true);
-                if (fabs(new_z_left - new_z) < 1.2f && fabs(new_z_right - new_z) < 1.2f)
+                // left and right of the destination
+                float side_x[2] = { temp_x + 1.0f* std::cos(angle+static_cast<float>(M_PI/2)), temp_x + 1.0f* std::cos(angle-static_cast<float>(M_PI/2)) };
+                float side_y[2] = { temp_y + 1.0f* std::sin(angle+static_cast<float>(M_PI/2)), temp_y + 1.0f* std::sin(angle-static_cast<float>(M_PI/2)) };
+                float side_z[2] = { z, z };
+                float new_z_side[2];
+                _map->GetHeights(owner.GetPhaseMask(), side_x, side_y, side_z, new_z_side, 2, true);
+                if (fabs(new_z_side[0] - new_z) < 1.2f && fabs(new_z_side[1] - new_z) < 1.2f)
                 {
                     x = temp_x;
                     y = temp_y;
@@ -567,25 +567,24 @@ void ReputationMgr::LoadFromDB(PreparedQueryResult result)
 
 void ReputationMgr::SaveToDB(SQLTransaction& trans)
 {
+    TransactionBatch batch(trans, CHAR_REP_CHAR_REPUTATION_BATCH, CHARACTER_BATCH_ROWS);
     for (FactionStateList::iterator itr = _factions.begin(); itr != _factions.end(); ++itr)
     {
         if (itr->second.needSave)
         {
-            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_REPUTATION_BY_FACTION);
-            stmt->setUInt32(0, _player->GetGUIDLow());
-            stmt->setUInt16(1, uint16(itr->second.ID));
-            trans->Append(stmt);
-
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_REPUTATION_BY_FACTION);
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_REPUTATION_BY_FACTION);
             stmt->setUInt32(0, _player->GetGUIDLow());
             stmt->setUInt16(1, uint16(itr->second.ID));
             stmt->setInt32(2, itr->second.Standing);
             stmt->setUInt16(3, uint16(itr->second.Flags));
-            trans->Append(stmt);
+            batch.Append(stmt);
 
             itr->second.needSave = false;
         }
     }
+
+    batch.Flush();
+    _player->UpdateSaveStats(batch);
 }
 
 void ReputationMgr::UpdateRankCounters(ReputationRank old_rank, ReputationRank new_rank)
@@ -407,7 +407,12 @@ void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket packet)
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(socket, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket packet)
+bool ScriptMgr::HasServerScripts() const
+{
+    return !SCR_REG_LST(ServerScript).empty();
+}
+
+void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket& packet)
 {
     ASSERT(socket);
 
@@ -928,7 +928,9 @@ class ScriptMgr
         void OnSocketOpen(WorldSocket* socket);
         void OnSocketClose(WorldSocket* socket, bool wasNew);
         void OnPacketReceive(WorldSocket* socket, WorldPacket packet);
-        void OnPacketSend(WorldSocket* socket, WorldPacket packet);
+        // packets are only copied for the hooks when a server script exists
+        bool HasServerScripts() const;
+        void OnPacketSend(WorldSocket* socket, WorldPacket& packet);
         void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet);
 
     public: /* WorldScript */
@@ -1363,9 +1363,24 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                    //process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   //packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                      //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                     //packet is thread-safe - process it in Map::Update()
+    // the following packets are thread-unsafe too, but only touch one subsystem and the session's own player,
+    // so World::UpdateSessions() may run them on session update threads while holding that subsystem's lock.
+    // Packets of these subsystems which change groups or teleport players stay PROCESS_THREADUNSAFE.
+    PROCESS_THREADUNSAFE_GUILD,                             //guild, guild bank
+    PROCESS_THREADUNSAFE_MAIL,                              //mail, auction house
+    PROCESS_THREADUNSAFE_CHANNEL,                           //chat channels
+    PROCESS_THREADUNSAFE_CALENDAR,                          //calendar
+    PROCESS_THREADUNSAFE_LFG,                               //dungeon finder, raid browser
+    PROCESS_THREADUNSAFE_WHO                                //who list
 };
 
+/// True for every packet which has to be processed in World::UpdateSessions()
+inline bool IsThreadUnsafePacketProcessing(PacketProcessing processing)
+{
+    return processing == PROCESS_THREADUNSAFE || processing >= PROCESS_THREADUNSAFE_GUILD;
+}
+
 class WorldPacket;
 
 struct OpcodeHandler
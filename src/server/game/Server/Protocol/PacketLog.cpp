@@ -18,16 +18,34 @@
 #include "stdafx.hpp"
 #include "PacketLog.h"
 #include "Config.h"
-#include "ByteBuffer.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "Timer.h"
+#include "Util.h"
 #include "WorldPacket.h"
 
-PacketLog::PacketLog() : _file(NULL)
+#include <cstring>
+
+namespace
+{
+    // never destroyed: network threads may still capture while static objects are destroyed
+    ThreadRingRegistry& GetPacketRings()
+    {
+        static ThreadRingRegistry* registry = new ThreadRingRegistry(PacketLog::RING_SIZE);
+        return *registry;
+    }
+}
+
+PacketLog::PacketLog() : ThreadRingWorker(GetPacketRings(), FLUSH_INTERVAL), _file(NULL), _format(PACKET_LOG_FORMAT_PARSER),
+    _sampleRate(1), _dropped(0), _reportedDrops(0), _reportTime(0)
 {
     Initialize();
 }
 
 PacketLog::~PacketLog()
 {
+    Stop();
+
     if (_file)
         fclose(_file);
 
@@ -43,21 +61,154 @@ void PacketLog::Initialize()
             logsDir.push_back('/');
 
     std::string logname = ConfigMgr::GetStringDefault("PacketLogFile", "");
-    if (!logname.empty())
-        _file = fopen((logsDir + logname).c_str(), "wb");
+    if (logname.empty())
+        return;
+
+    _format = ConfigMgr::GetIntDefault("PacketLogFormat", 0) == 1 ? PACKET_LOG_FORMAT_SESSION : PACKET_LOG_FORMAT_PARSER;
+    _sampleRate = std::max(ConfigMgr::GetIntDefault("PacketLogSampleRate", 1), 1);
+
+    Tokenizer accounts(ConfigMgr::GetStringDefault("PacketLogAccounts", ""), ' ');
+    for (Tokenizer::const_iterator itr = accounts.begin(); itr != accounts.end(); ++itr)
+        _accounts.insert(uint32(strtoul(*itr, NULL, 0)));
+
+    Tokenizer opcodes(ConfigMgr::GetStringDefault("PacketLogOpcodes", ""), ' ');
+    for (Tokenizer::const_iterator itr = opcodes.begin(); itr != opcodes.end(); ++itr)
+    {
+        uint32 opcode = uint32(strtoul(*itr, NULL, 0));
+        if (opcode >= NUM_MSG_TYPES)
+            continue;
+
+        _opcodes.resize(NUM_MSG_TYPES, false);
+        _opcodes[opcode] = true;
+    }
+
+    _file = fopen((logsDir + logname).c_str(), "wb");
+    if (!_file)
+        return;
+
+    if (_format == PACKET_LOG_FORMAT_SESSION)
+    {
+        PacketLogFileHeader header;
+        memcpy(header.signature, PACKET_LOG_SIGNATURE, sizeof(header.signature));
+        header.version = PACKET_LOG_VERSION;
+        fwrite(&header, sizeof(header), 1, _file);
+    }
+
+    _reportTime = getMSTime();
+    if (!Start())
+    {
+        fclose(_file);
+        _file = NULL;
+    }
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction)
+bool PacketLog::CanLogPacket(uint16 opcode, uint32 accountId) const
 {
-    ByteBuffer data(4+4+4+1+packet.size());
-    data << int32(packet.GetOpcode());
-    data << int32(packet.size());
-    data << uint32(time(NULL));
-    data << uint8(direction);
+    if (!_opcodes.empty() && (opcode >= _opcodes.size() || !_opcodes[opcode]))
+        return false;
+
+    if (!_accounts.empty() && _accounts.find(accountId) == _accounts.end())
+        return false;
 
-    for (uint32 i = 0; i < packet.size(); i++)
-        data << const_cast<WorldPacket&>(packet)[i];
+    // accountId 0 would sample every connection which did not authenticate yet
+    if (_sampleRate > 1)
+        return accountId && accountId % _sampleRate == 0;
 
-    fwrite(data.contents(), 1, data.size(), _file);
+    return true;
+}
+
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, uint32 accountId)
+{
+    LogPacket(packet.GetOpcode(), packet.contents(), packet.size(), direction, accountId);
+}
+
+void PacketLog::LogPacket(uint16 opcode, uint8 const* data, size_t size, Direction direction, uint32 accountId)
+{
+    if (!CanLogPacket(opcode, accountId))
+        return;
+
+    uint8 header[sizeof(PacketLogSessionRecord)];
+    size_t headerSize;
+    if (_format == PACKET_LOG_FORMAT_SESSION)
+    {
+        PacketLogSessionRecord record;
+        record.accountId = accountId;
+        record.time = getMSTime();
+        record.size = uint32(size);
+        record.opcode = opcode;
+        record.direction = uint8(direction);
+        memcpy(header, &record, sizeof(record));
+        headerSize = sizeof(record);
+    }
+    else
+    {
+        ByteBuffer buf(13);
+        buf << int32(opcode);
+        buf << int32(size);
+        buf << uint32(time(NULL));
+        buf << uint8(direction);
+        memcpy(header, buf.contents(), buf.size());
+        headerSize = buf.size();
+    }
+
+    ThreadRing* ring = GetRegistry().GetThreadRing();
+    size_t const recordSize = headerSize + size;
+
+    // never stall a network thread for the capture
+    if (ring->Free() < recordSize)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        Wakeup();
+        return;
+    }
+
+    size_t pos = ring->GetHead();
+    ring->Write(pos, header, headerSize);
+    if (size)
+        ring->Write(pos + headerSize, data, size);
+    ring->Publish(pos + recordSize);
+
+    if (ring->Used() > RING_SIZE / 2)
+        Wakeup();
+}
+
+bool PacketLog::Drain(std::vector<ThreadRing*> const& rings)
+{
+    bool written = false;
+    for (std::vector<ThreadRing*>::const_iterator itr = rings.begin(); itr != rings.end(); ++itr)
+    {
+        ThreadRing* ring = *itr;
+        size_t const tail = ring->GetTail();
+        size_t const head = ring->GetPublishedHead();
+        if (head == tail)
+            continue;
+
+        // records are stored exactly as they go to the file
+        char const* data;
+        size_t first = ring->GetSpan(tail, head - tail, data);
+        fwrite(data, 1, first, _file);
+        if (first < head - tail)
+        {
+            ring->GetSpan(tail + first, head - tail - first, data);
+            fwrite(data, 1, head - tail - first, _file);
+        }
+
+        ring->Consume(head);
+        written = true;
+    }
+
+    uint64 dropped = GetDroppedPackets();
+    if (dropped != _reportedDrops && getMSTimeDiff(_reportTime, getMSTime()) >= IN_MILLISECONDS)
+    {
+        sLog->outWarn(LOG_FILTER_NETWORKIO, "PacketLog: capture ring full, " UI64FMTD " packets dropped so far", dropped);
+        _reportedDrops = dropped;
+        _reportTime = getMSTime();
+    }
+
+    return written;
+}
+
+void PacketLog::Flush()
+{
     fflush(_file);
 }
@@ -19,17 +19,59 @@
 #define TRINITY_PACKETLOG_H
 
 #include "Common.h"
+#include "ThreadRing.h"
 #include <ace/Singleton.h>
 
+#include <atomic>
+#include <set>
+#include <vector>
+
 enum Direction
 {
     CLIENT_TO_SERVER,
     SERVER_TO_CLIENT
 };
 
+enum PacketLogFormat
+{
+    PACKET_LOG_FORMAT_PARSER    = 0,                        // int32 opcode, int32 size, uint32 unix time, uint8 direction, data - read by WowPacketParser
+    PACKET_LOG_FORMAT_SESSION   = 1                         // PacketLogFileHeader, then PacketLogSessionRecord + data - read by the packet replay
+};
+
+#pragma pack(push, 1)
+
+struct PacketLogFileHeader
+{
+    char signature[4];                                      // "TCPL"
+    uint16 version;
+};
+
+struct PacketLogSessionRecord
+{
+    uint32 accountId;                                       // 0 before the session was authenticated
+    uint32 time;                                            // getMSTime()
+    uint32 size;
+    uint16 opcode;
+    uint8 direction;
+};
+
+#pragma pack(pop)
+
+#define PACKET_LOG_SIGNATURE "TCPL"
+#define PACKET_LOG_VERSION   1
+
 class WorldPacket;
 
-class PacketLog
+/*
+    Network threads copy captured packets into a ThreadRing of their own
+    without taking a lock; a full ring drops the packet instead of stalling
+    the connection. The writer thread empties the rings every
+    FLUSH_INTERVAL ms (or when one is half full) and flushes the file once
+    per batch. PacketLogAccounts, PacketLogOpcodes and PacketLogSampleRate
+    restrict the capture to some sessions or opcodes, sampling skips
+    sessions which are not authenticated yet.
+*/
+class PacketLog : protected ThreadRingWorker
 {
     friend class ACE_Singleton<PacketLog, ACE_Thread_Mutex>;
 
@@ -38,12 +80,33 @@ class PacketLog
         ~PacketLog();
 
     public:
+        enum
+        {
+            RING_SIZE       = 1024 * 1024,
+            FLUSH_INTERVAL  = 100                           // ms
+        };
+
         void Initialize();
         bool CanLogPacket() const { return (_file != NULL); }
-        void LogPacket(WorldPacket const& packet, Direction direction);
+        bool CanLogPacket(uint16 opcode, uint32 accountId) const;
+        void LogPacket(uint16 opcode, uint8 const* data, size_t size, Direction direction, uint32 accountId);
+        void LogPacket(WorldPacket const& packet, Direction direction, uint32 accountId);
+
+        uint64 GetDroppedPackets() const { return _dropped.load(std::memory_order_relaxed); }
 
     private:
+        bool Drain(std::vector<ThreadRing*> const& rings);
+        void Flush();
+
         FILE* _file;
+        PacketLogFormat _format;
+        std::set<uint32> _accounts;                         // empty: all accounts
+        std::vector<bool> _opcodes;                         // empty: all opcodes
+        uint32 _sampleRate;                                 // capture accounts with accountId % _sampleRate == 0
+
+        std::atomic<uint64> _dropped;
+        uint64 _reportedDrops;
+        uint32 _reportTime;
 };
 
 #define sPacketLog ACE_Singleton<PacketLog, ACE_Thread_Mutex>::instance()
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "PacketReplay.h"
+#include "PacketLog.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "Timer.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <cstring>
+
+PacketReplay::PacketReplay() : _next(0), _speed(1.0f), _elapsed(0.0), _running(false)
+{
+}
+
+bool PacketReplay::Load(std::string const& fileName, std::string& error)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+    {
+        error = "cannot open " + fileName;
+        return false;
+    }
+
+    PacketLogFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.signature, PACKET_LOG_SIGNATURE, sizeof(header.signature)) || header.version != PACKET_LOG_VERSION)
+    {
+        fclose(file);
+        error = fileName + " is not a session capture (PacketLogFormat = 1)";
+        return false;
+    }
+
+    _packets.clear();
+    _accounts.clear();
+
+    bool first = true;
+    uint32 firstTime = 0;
+    PacketLogSessionRecord record;
+    while (fread(&record, sizeof(record), 1, file) == 1)
+    {
+        ReplayPacket packet;
+        packet.data.resize(record.size);
+        if (record.size && fread(&packet.data[0], record.size, 1, file) != 1)
+            break;                                          // capture cut off while writing
+
+        if (first)
+        {
+            firstTime = record.time;
+            first = false;
+        }
+
+        // handled by WorldSocket, the replayed sessions are authenticated already
+        if (record.direction != CLIENT_TO_SERVER || !record.accountId || record.opcode >= NUM_MSG_TYPES ||
+            record.opcode == CMSG_AUTH_SESSION || record.opcode == CMSG_PING || record.opcode == CMSG_KEEP_ALIVE)
+            continue;
+
+        packet.accountId = record.accountId;
+        packet.time = getMSTimeDiff(firstTime, record.time);
+        packet.opcode = record.opcode;
+        _packets.push_back(packet);
+        _accounts.push_back(record.accountId);
+    }
+
+    fclose(file);
+
+    // the writer thread empties the capture rings of several threads per batch, sessions only keep their own order
+    std::stable_sort(_packets.begin(), _packets.end(), [](ReplayPacket const& a, ReplayPacket const& b) { return a.time < b.time; });
+
+    std::sort(_accounts.begin(), _accounts.end());
+    _accounts.erase(std::unique(_accounts.begin(), _accounts.end()), _accounts.end());
+
+    if (_packets.empty())
+    {
+        error = fileName + " contains no client packets of authenticated sessions";
+        return false;
+    }
+
+    return true;
+}
+
+bool PacketReplay::Start(std::string const& fileName, float speed, std::string& error)
+{
+    if (_running)
+    {
+        error = "a replay of " + _fileName + " is running";
+        return false;
+    }
+
+    if (!Load(fileName, error))
+        return false;
+
+    for (std::vector<uint32>::const_iterator itr = _accounts.begin(); itr != _accounts.end(); ++itr)
+    {
+        if (sWorld->FindSession(*itr))
+        {
+            error = "account " + std::to_string(*itr) + " of the capture is logged in";
+            _packets.clear();
+            return false;
+        }
+    }
+
+    for (std::vector<uint32>::const_iterator itr = _accounts.begin(); itr != _accounts.end(); ++itr)
+    {
+        WorldSession* session = new WorldSession(*itr, NULL, SEC_PLAYER, uint8(sWorld->getIntConfig(CONFIG_EXPANSION)), 0, LOCALE_enUS, 0, false);
+        session->SetReplay(true);
+        sWorld->AddSession(session);
+    }
+
+    _fileName = fileName;
+    _speed = std::max(speed, 0.01f);
+    _elapsed = 0.0;
+    _next = 0;
+    _stats = Stats();
+    _stats.packets = uint32(_packets.size());
+    _stats.sessions = uint32(_accounts.size());
+    _running = true;
+
+    sLog->outInfo(LOG_FILTER_WORLDSERVER, "PacketReplay: replaying %u packets of %u sessions from %s at speed %.2f",
+        _stats.packets, _stats.sessions, _fileName.c_str(), _speed);
+    return true;
+}
+
+void PacketReplay::Stop()
+{
+    if (!_running)
+        return;
+
+    // the sessions process what was queued in this tick and log out
+    for (std::vector<uint32>::const_iterator itr = _accounts.begin(); itr != _accounts.end(); ++itr)
+        if (WorldSession* session = sWorld->FindSession(*itr))
+            if (session->IsReplay())
+                session->SetReplay(false);
+
+    _running = false;
+    _packets.clear();
+
+    sLog->outInfo(LOG_FILTER_WORLDSERVER, "PacketReplay: %s finished, %u of %u packets queued in %u ticks, world diff avg %u ms max %u ms",
+        _fileName.c_str(), _stats.queued, _stats.packets, _stats.ticks, _stats.ticks ? uint32(_stats.diffSum / _stats.ticks) : 0, _stats.maxDiff);
+}
+
+void PacketReplay::Update(uint32 diff)
+{
+    if (!_running)
+        return;
+
+    // stop one tick after the last packet was queued, so the sessions process it first
+    if (_next == _packets.size())
+    {
+        Stop();
+        return;
+    }
+
+    ++_stats.ticks;
+    _stats.diffSum += diff;
+    _stats.maxDiff = std::max(_stats.maxDiff, diff);
+
+    _elapsed += diff * _speed;
+    for (; _next < _packets.size() && _packets[_next].time <= _elapsed; ++_next)
+    {
+        ReplayPacket& packet = _packets[_next];
+        WorldSession* session = sWorld->FindSession(packet.accountId);
+        if (!session || !session->IsReplay())
+            continue;
+
+        WorldPacket* worldPacket = new WorldPacket(packet.opcode, packet.data.size());
+        if (!packet.data.empty())
+            worldPacket->append(&packet.data[0], packet.data.size());
+
+        session->QueuePacket(worldPacket);
+        ++_stats.queued;
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PACKETREPLAY_H
+#define TRINITY_PACKETREPLAY_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+
+#include <vector>
+
+/*
+    Feeds the client packets of a capture written with PacketLogFormat = 1
+    back into the world: every captured account gets a WorldSession without
+    socket, and the packets are queued to it at their original pace (scaled
+    by the replay speed) from World::UpdateSessions(). The characters and
+    accounts of the capture must exist in the local databases. When the
+    last packet was queued the sessions log out and the world update times
+    seen during the replay are logged, which makes a captured session an
+    offline benchmark.
+*/
+class PacketReplay
+{
+    friend class ACE_Singleton<PacketReplay, ACE_Null_Mutex>;
+
+    private:
+        PacketReplay();
+        ~PacketReplay() { }
+
+    public:
+        struct Stats
+        {
+            Stats() : packets(0), queued(0), sessions(0), ticks(0), diffSum(0), maxDiff(0) { }
+
+            uint32 packets;
+            uint32 queued;
+            uint32 sessions;
+            uint32 ticks;
+            uint64 diffSum;
+            uint32 maxDiff;
+        };
+
+        // all methods must be called from the world thread
+        bool Start(std::string const& fileName, float speed, std::string& error);
+        void Stop();
+        void Update(uint32 diff);
+
+        bool IsRunning() const { return _running; }
+        std::string const& GetFileName() const { return _fileName; }
+        Stats const& GetStats() const { return _stats; }
+
+    private:
+        struct ReplayPacket
+        {
+            uint32 accountId;
+            uint32 time;                                    // ms since the first captured packet
+            uint16 opcode;
+            std::vector<uint8> data;
+        };
+
+        bool Load(std::string const& fileName, std::string& error);
+
+        std::vector<ReplayPacket> _packets;
+        std::vector<uint32> _accounts;
+        std::string _fileName;
+        size_t _next;
+        float _speed;
+        double _elapsed;
+        bool _running;
+        Stats _stats;
+};
+
+#define sPacketReplay ACE_Singleton<PacketReplay, ACE_Null_Mutex>::instance()
+#endif
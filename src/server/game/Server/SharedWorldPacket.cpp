@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stdafx.hpp"
+#include <ace/Atomic_Op.h>
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+#include "SharedWorldPacket.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+namespace
+{
+    // the payload reference count is changed by map threads queueing and network threads releasing,
+    // packets are spread over a few locks instead of sharing a single one
+    enum { PAYLOAD_LOCK_COUNT = 16 };
+
+    ACE_Lock_Adapter<ACE_Thread_Mutex> PayloadLocks[PAYLOAD_LOCK_COUNT];
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> NextPayloadLock;
+}
+
+SharedWorldPacket::SharedWorldPacket(WorldPacket const& packet) : m_opcode(packet.GetOpcode()), m_size(packet.size()), m_payload(NULL)
+{
+    if (!m_size)
+        return;
+
+    ACE_Lock* lock = &PayloadLocks[(NextPayloadLock++) % PAYLOAD_LOCK_COUNT];
+    m_payload = new ACE_Message_Block(m_size, ACE_Message_Block::MB_DATA, NULL, NULL, NULL, lock);
+    m_payload->copy((char const*)packet.contents(), m_size);
+}
+
+SharedWorldPacket::SharedWorldPacket(SharedWorldPacket const& right) : m_opcode(right.m_opcode), m_size(right.m_size), m_payload(right.DuplicatePayload())
+{
+}
+
+SharedWorldPacket::~SharedWorldPacket()
+{
+    if (m_payload)
+        m_payload->release();
+}
+
+char const* SharedWorldPacket::contents() const
+{
+    return m_payload ? m_payload->rd_ptr() : NULL;
+}
+
+ACE_Message_Block* SharedWorldPacket::DuplicatePayload() const
+{
+    return m_payload ? m_payload->duplicate() : NULL;
+}
+
+WorldPacket SharedWorldPacket::ToWorldPacket() const
+{
+    WorldPacket packet(m_opcode, m_size);
+    if (m_size)
+        packet.append((uint8 const*)contents(), m_size);
+    return packet;
+}
+
+SharedWorldPacketSender::~SharedWorldPacketSender()
+{
+    delete m_shared;
+}
+
+void SharedWorldPacketSender::SendTo(WorldSession* session)
+{
+    if (!m_sent)
+    {
+        session->SendPacket(m_packet);
+        m_sent = true;
+        return;
+    }
+
+    if (!m_shared)
+        m_shared = new SharedWorldPacket(*m_packet);
+    session->SendPacket(m_shared);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __SHAREDWORLDPACKET_H
+#define __SHAREDWORLDPACKET_H
+
+#include "Define.h"
+
+class ACE_Message_Block;
+class WorldPacket;
+class WorldSession;
+
+/// Immutable copy of a packet payload with reference counted storage.
+/// A packet broadcast to many players is copied once, every socket then
+/// queues the same buffer; headers are still built and encrypted per socket.
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& packet);
+        SharedWorldPacket(SharedWorldPacket const& right);
+        ~SharedWorldPacket();
+
+        uint16 GetOpcode() const { return m_opcode; }
+        size_t size() const { return m_size; }
+        char const* contents() const;
+
+        /// Message block sharing the payload, released by the caller. NULL for empty packets.
+        ACE_Message_Block* DuplicatePayload() const;
+
+        /// Writable copy, only for packet logging and script hooks.
+        WorldPacket ToWorldPacket() const;
+
+    private:
+        SharedWorldPacket& operator=(SharedWorldPacket const&);
+
+        uint16 m_opcode;
+        size_t m_size;
+        ACE_Message_Block* m_payload;
+};
+
+/// Sends one packet to several sessions. The first session gets the packet itself,
+/// the payload is only copied into a SharedWorldPacket once a second session is found.
+class SharedWorldPacketSender
+{
+    public:
+        explicit SharedWorldPacketSender(WorldPacket const* packet) : m_packet(packet), m_sent(false), m_shared(NULL) { }
+        ~SharedWorldPacketSender();
+
+        void SendTo(WorldSession* session);
+
+    private:
+        SharedWorldPacketSender(SharedWorldPacketSender const&);
+        SharedWorldPacketSender& operator=(SharedWorldPacketSender const&);
+
+        WorldPacket const* m_packet;
+        bool m_sent;
+        SharedWorldPacket* m_shared;
+};
+
+#endif
@@ -27,6 +27,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "Vehicle.h"
@@ -40,6 +41,7 @@
 #include "OutdoorPvPMgr.h"
 #include "MapManager.h"
 #include "SocialMgr.h"
+#include "WhoListIndex.h"
 #include "zlib.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
@@ -50,6 +52,63 @@ namespace {
 
 std::string const DefaultPlayerName = "<none>";
 
+/// Subsystem locks taken by the packets processed in WorldSession::UpdateParallel(), always acquired in bit order
+enum PacketLockDomain
+{
+    PACKET_LOCK_GUILD       = 0x01,
+    PACKET_LOCK_CALENDAR    = 0x02,
+    PACKET_LOCK_MAIL        = 0x04,
+    PACKET_LOCK_CHANNEL     = 0x08,
+    PACKET_LOCK_LFG         = 0x10,
+    MAX_PACKET_LOCK_DOMAINS = 5
+};
+
+ACE_Thread_Mutex PacketLocks[MAX_PACKET_LOCK_DOMAINS];
+
+uint32 GetPacketLockDomains(PacketProcessing processing)
+{
+    switch (processing)
+    {
+        // guilds create and remove calendar events and calendar events send mail
+        case PROCESS_THREADUNSAFE_GUILD:
+        case PROCESS_THREADUNSAFE_CALENDAR:
+            return PACKET_LOCK_GUILD | PACKET_LOCK_CALENDAR | PACKET_LOCK_MAIL;
+        // auctions are paid out by mail
+        case PROCESS_THREADUNSAFE_MAIL:
+            return PACKET_LOCK_MAIL;
+        case PROCESS_THREADUNSAFE_CHANNEL:
+            return PACKET_LOCK_CHANNEL;
+        case PROCESS_THREADUNSAFE_LFG:
+            return PACKET_LOCK_LFG;
+        // the who list reads guild names
+        case PROCESS_THREADUNSAFE_WHO:
+            return PACKET_LOCK_GUILD;
+        default:
+            return 0;
+    }
+}
+
+class PacketLockGuard
+{
+    public:
+        explicit PacketLockGuard(uint32 domains) : _domains(domains)
+        {
+            for (uint8 i = 0; i < MAX_PACKET_LOCK_DOMAINS; ++i)
+                if (_domains & (1 << i))
+                    PacketLocks[i].acquire();
+        }
+
+        ~PacketLockGuard()
+        {
+            for (uint8 i = MAX_PACKET_LOCK_DOMAINS; i > 0; --i)
+                if (_domains & (1 << (i - 1)))
+                    PacketLocks[i - 1].release();
+        }
+
+    private:
+        uint32 const _domains;
+};
+
 } // namespace
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -61,7 +120,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle.packetProcessing == PROCESS_THREADUNSAFE)
+    if (IsThreadUnsafePacketProcessing(opHandle.packetProcessing))
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -82,7 +141,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle.packetProcessing == PROCESS_THREADUNSAFE)
+    if (IsThreadUnsafePacketProcessing(opHandle.packetProcessing))
         return true;
 
     //no player attached? -> our client! ^^
@@ -94,9 +153,27 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+//only packets of a single subsystem, and only while the player is in world,
+//everything else stops the parallel pass and is left to WorldSessionFilter
+bool ParallelSessionFilter::Process(WorldPacket* packet)
+{
+    if (packet->GetOpcode() >= NUM_MSG_TYPES)
+        return false;
+
+    OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
+    if (opHandle.status != STATUS_LOGGEDIN || !GetPacketLockDomains(opHandle.packetProcessing))
+        return false;
+
+    Player* player = m_pSession->GetPlayer();
+    if (!player || m_pSession->PlayerLogout())
+        return false;
+
+    return player->IsInWorld();
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter):
-m_muteTime(mute_time), m_timeOutTime(0), _player(NULL), m_Socket(sock),
+m_muteTime(mute_time), m_timeOutTime(0), _player(NULL), m_Socket(sock), m_replay(false),
 _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
 m_inQueue(false), m_playerLoading(false), m_playerLogout(false),
 m_playerRecentlyLogout(false), m_playerSave(false),
@@ -210,6 +287,16 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket();
 }
 
+/// Send a packet whose payload is shared with other receivers
+void WorldSession::SendPacket(SharedWorldPacket const* packet)
+{
+    if (!m_Socket)
+        return;
+
+    if (m_Socket->SendPacket(*packet) == -1)
+        m_Socket->CloseSocket();
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -219,17 +306,52 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason)
 {
-    sLog->outError(LOG_FILTER_OPCODES, "Received unexpected opcode %s Status: %s Reason: %s from %s",
+    TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received unexpected opcode %s Status: %s Reason: %s from %s",
         GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), status, reason, GetPlayerInfo().c_str());
 }
 
+/// Packets are processed while the socket is open, or without a socket when the session is replayed
+bool WorldSession::IsConnectionOpen() const
+{
+    return m_Socket ? !m_Socket->IsClosed() : m_replay;
+}
+
+/// Process the packets at the front of the queue which only need a subsystem lock.
+/// Runs on the session update threads while World::UpdateSessions() waits, each session on exactly one thread;
+/// stops at the first packet which has to stay serial so the packet order of the session is kept.
+void WorldSession::UpdateParallel()
+{
+    ParallelSessionFilter filter(this);
+    WorldPacket* packet = NULL;
+
+    while (IsConnectionOpen() && _recvQueue.next(packet, filter))
+    {
+        OpcodeHandler& opHandle = opcodeTable[packet->GetOpcode()];
+        try
+        {
+            PacketLockGuard guard(GetPacketLockDomains(opHandle.packetProcessing));
+            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+            (this->*opHandle.handler)(*packet);
+            LogUnprocessedTail(packet);
+        }
+        catch(ByteBufferException &)
+        {
+            sLog->outError(LOG_FILTER_GENERAL, "WorldSession::UpdateParallel ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i. Skipped packet.",
+                    packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+            packet->hexlike();
+        }
+
+        delete packet;
+    }
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnprocessedTail(WorldPacket* packet)
 {
     if (!sLog->ShouldLog(LOG_FILTER_OPCODES, LOG_LEVEL_TRACE) || packet->rpos() >= packet->wpos())
         return;
 
-    sLog->outTrace(LOG_FILTER_OPCODES, "Unprocessed tail data (read stop at %u from %u) Opcode %s from %s",
+    TC_LOG_TRACE(LOG_FILTER_OPCODES, "Unprocessed tail data (read stop at %u from %u) Opcode %s from %s",
         uint32(packet->rpos()), uint32(packet->wpos()), GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), GetPlayerInfo().c_str());
     packet->print_storage();
 }
@@ -242,7 +364,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
-    if (IsConnectionIdle())
+    if (m_Socket && IsConnectionIdle())
         m_Socket->CloseSocket();
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
@@ -257,13 +379,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! delayed packets that were re-enqueued due to improper timing. To prevent an infinite
     //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
-    while (m_Socket && !m_Socket->IsClosed() &&
+    while (IsConnectionOpen() &&
             !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
             _recvQueue.next(packet, updater))
     {
         if (packet->GetOpcode() >= NUM_MSG_TYPES)
         {
-            sLog->outError(LOG_FILTER_OPCODES, "Received non-existed opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
+            TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received non-existed opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
                             , GetPlayerInfo().c_str());
             sScriptMgr->OnUnknownPacketReceive(m_Socket, WorldPacket(*packet));
         }
@@ -289,7 +411,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                                 deletePacket = false;
                                 QueuePacket(packet);
                                 //! Log
-                                sLog->outDebug(LOG_FILTER_NETWORKIO, "Re-enqueueing packet with opcode %s with with status STATUS_LOGGEDIN. "
+                                TC_LOG_DEBUG(LOG_FILTER_NETWORKIO, "Re-enqueueing packet with opcode %s with with status STATUS_LOGGEDIN. "
                                     "Player is currently not in world yet.", GetOpcodeNameForLogging(packet->GetOpcode()).c_str());
                             }
                         }
@@ -343,11 +465,11 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         LogUnprocessedTail(packet);
                         break;
                     case STATUS_NEVER:
-                        sLog->outError(LOG_FILTER_OPCODES, "Received not allowed opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
+                        TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received not allowed opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
                             , GetPlayerInfo().c_str());
                         break;
                     case STATUS_UNHANDLED:
-                        sLog->outDebug(LOG_FILTER_OPCODES, "Received not handled opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
+                        TC_LOG_DEBUG(LOG_FILTER_OPCODES, "Received not handled opcode %s from %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str()
                             , GetPlayerInfo().c_str());
                         break;
                 }
@@ -388,7 +510,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             m_Socket = NULL;
         }
 
-        if (!m_Socket)
+        if (!m_Socket && !m_replay)
             return false;                                       //Will remove this session from the world session map
     }
 
@@ -526,6 +648,7 @@ void WorldSession::LogoutPlayer(bool Save)
         //! Broadcast a logout message to the player's friends
         sSocialMgr->SendFriendStatus(_player, FRIEND_OFFLINE, _player->GetGUIDLow(), true);
         sSocialMgr->RemovePlayerSocial(_player->GetGUIDLow());
+        sWhoListIndex->RemovePlayer(_player->GetGUIDLow());
 
         //! Call script hook before deletion
         sScriptMgr->OnPlayerLogout(_player);
@@ -626,25 +749,25 @@ const char *WorldSession::GetTrinityString(int32 entry) const
 
 void WorldSession::Handle_NULL(WorldPacket& recvPacket)
 {
-    sLog->outError(LOG_FILTER_OPCODES, "Received unhandled opcode %s from %s"
+    TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received unhandled opcode %s from %s"
         , GetOpcodeNameForLogging(recvPacket.GetOpcode()).c_str(), GetPlayerInfo().c_str());
 }
 
 void WorldSession::Handle_EarlyProccess(WorldPacket& recvPacket)
 {
-    sLog->outError(LOG_FILTER_OPCODES, "Received opcode %s that must be processed in WorldSocket::OnRead from %s"
+    TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received opcode %s that must be processed in WorldSocket::OnRead from %s"
         , GetOpcodeNameForLogging(recvPacket.GetOpcode()).c_str(), GetPlayerInfo().c_str());
 }
 
 void WorldSession::Handle_ServerSide(WorldPacket& recvPacket)
 {
-    sLog->outError(LOG_FILTER_OPCODES, "Received server-side opcode %s from %s"
+    TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received server-side opcode %s from %s"
         , GetOpcodeNameForLogging(recvPacket.GetOpcode()).c_str(), GetPlayerInfo().c_str());
 }
 
 void WorldSession::Handle_Deprecated(WorldPacket& recvPacket)
 {
-    sLog->outError(LOG_FILTER_OPCODES, "Received deprecated opcode %s from %s"
+    TC_LOG_ERROR(LOG_FILTER_OPCODES, "Received deprecated opcode %s from %s"
         , GetOpcodeNameForLogging(recvPacket.GetOpcode()).c_str(), GetPlayerInfo().c_str());
 }
 
@@ -40,6 +40,7 @@ class Object;
 class Player;
 class Quest;
 class SpellCastTargets;
+class SharedWorldPacket;
 class Unit;
 class Warden;
 class WorldPacket;
@@ -153,6 +154,18 @@ public:
     virtual bool Process(WorldPacket* packet);
 };
 
+//process only the subsystem-local thread-unsafe packets on the session update threads
+//before the serial World::UpdateSessions() pass
+class ParallelSessionFilter : public PacketFilter
+{
+public:
+    explicit ParallelSessionFilter(WorldSession* pSession) : PacketFilter(pSession) {}
+    ~ParallelSessionFilter() {}
+
+    virtual bool Process(WorldPacket* packet);
+    virtual bool ProcessLogout() const { return false; }
+};
+
 // Proxy structure to contain data passed to callback function,
 // only to prevent bloating the parameter list
 class CharacterCreateInfo
@@ -195,6 +208,9 @@ class WorldSession
 
         bool PlayerLoading() const { return m_playerLoading; }
         bool PlayerLogout() const { return m_playerLogout; }
+        /// Session without socket fed by the PacketReplay, kept alive until the replay ends
+        bool IsReplay() const { return m_replay; }
+        void SetReplay(bool replay) { m_replay = replay; }
         bool PlayerLogoutWithSave() const { return m_playerLogout && m_playerSave; }
         bool PlayerRecentlyLoggedOut() const { return m_playerRecentlyLogout; }
 
@@ -205,6 +221,7 @@ class WorldSession
         void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(SharedWorldPacket const* packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -253,6 +270,8 @@ class WorldSession
 
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
+        /// Process the leading packets which may run on a session update thread, see PROCESS_THREADUNSAFE_GUILD
+        void UpdateParallel();
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
@@ -359,6 +378,7 @@ class WorldSession
         {
             m_timeOutTime = sWorld->getIntConfig(CONFIG_SOCKET_TIMEOUTTIME);
         }
+        bool IsConnectionOpen() const;
         bool IsConnectionIdle() const
         {
             return (m_timeOutTime <= 0 && !m_inQueue);
@@ -927,6 +947,7 @@ class WorldSession
         uint32 m_GUIDLow;                                   // set loggined or recently logout player (while m_playerRecentlyLogout set)
         Player* _player;
         WorldSocket* m_Socket;
+        bool m_replay;
         std::string m_Address;
 
         AccountTypes _security;
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "WorldSessionUpdater.h"
+#include "WorldSession.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+namespace {
+
+// sessions claimed at once, most of them have nothing to do so single claims would only add contention
+size_t const SessionChunkSize = 16;
+
+} // namespace
+
+WorldSessionUpdater::WorldSessionUpdater():
+m_mutex(), m_condition(m_mutex), m_workCondition(m_mutex), m_sessions(NULL), m_nextSession(0),
+m_busyThreads(0), m_threads(0), m_tick(0), m_activated(false), m_shutdown(false)
+{
+}
+
+WorldSessionUpdater::~WorldSessionUpdater()
+{
+    deactivate();
+}
+
+int WorldSessionUpdater::activate(size_t num_threads)
+{
+    if (m_activated || num_threads < 1)
+        return -1;
+
+    m_shutdown = false;
+    m_threads = num_threads;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE, int(num_threads)) == -1)
+        return -1;
+
+    m_activated = true;
+    return 0;
+}
+
+int WorldSessionUpdater::deactivate()
+{
+    if (!m_activated)
+        return -1;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_activated = false;
+        m_shutdown = true;
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+    return 0;
+}
+
+void WorldSessionUpdater::update(std::vector<WorldSession*> const& sessions)
+{
+    if (!m_activated || sessions.empty())
+        return;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    m_sessions = &sessions;
+    m_nextSession = 0;
+    m_busyThreads = m_threads;
+    ++m_tick;
+    m_workCondition.broadcast();
+
+    while (m_busyThreads > 0)
+        m_condition.wait();
+
+    m_sessions = NULL;
+}
+
+int WorldSessionUpdater::svc()
+{
+    uint32 lastTick = 0;
+
+    for (;;)
+    {
+        std::vector<WorldSession*> const* sessions;
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            while (!m_shutdown && m_tick == lastTick)
+                m_workCondition.wait();
+
+            if (m_shutdown)
+                break;
+
+            lastTick = m_tick;
+            sessions = m_sessions;
+        }
+
+        size_t const count = sessions->size();
+        for (size_t first; (first = m_nextSession.fetch_add(SessionChunkSize)) < count;)
+        {
+            size_t const last = std::min(first + SessionChunkSize, count);
+            for (size_t i = first; i < last; ++i)
+                (*sessions)[i]->UpdateParallel();
+        }
+
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        if (--m_busyThreads == 0)
+            m_condition.signal();
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLD_SESSION_UPDATER_H_INCLUDED
+#define _WORLD_SESSION_UPDATER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Task.h>
+
+#include <atomic>
+#include <vector>
+
+#include "Define.h"
+
+class WorldSession;
+
+/*
+    Runs WorldSession::UpdateParallel() for every session on a fixed set of
+    threads at the start of World::UpdateSessions(). The world thread hands
+    over the session list and blocks until all of it was processed, so the
+    session map is never modified while the threads run. Threads claim small
+    chunks of the list through an atomic index: every session is handled by
+    exactly one thread per tick, which keeps its packets in order.
+*/
+class WorldSessionUpdater : protected ACE_Task_Base
+{
+    public:
+
+        WorldSessionUpdater();
+        virtual ~WorldSessionUpdater();
+
+        int activate(size_t num_threads);
+
+        int deactivate();
+
+        bool activated() const { return m_activated; }
+
+        void update(std::vector<WorldSession*> const& sessions);
+
+        virtual int svc();
+
+    private:
+
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when the last thread finished the tick
+        ACE_Condition_Thread_Mutex m_workCondition;         // signaled when a tick started
+        std::vector<WorldSession*> const* m_sessions;
+        std::atomic<size_t> m_nextSession;
+        size_t m_busyThreads;
+        size_t m_threads;
+        uint32 m_tick;
+        bool m_activated;
+        bool m_shutdown;
+};
+
+#endif //_WORLD_SESSION_UPDATER_H_INCLUDED
@@ -45,6 +45,7 @@
 #include "Log.h"
 #include "PacketLog.h"
 #include "ScriptMgr.h"
+#include "SharedWorldPacket.h"
 #include "AccountMgr.h"
 
 #if defined(__GNUC__)
@@ -100,6 +101,9 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+/// Shared payloads up to this size are copied into the output buffer like regular packets.
+static const size_t SHARED_PACKET_COPY_SIZE = 128;
+
 WorldSocket::WorldSocket (void): WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
@@ -160,27 +164,52 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     if (closing_)
         return -1;
 
+    return AppendPacket(pct.GetOpcode(), (const char*) pct.contents(), pct.size(), NULL);
+}
+
+int WorldSocket::SendPacket(SharedWorldPacket const& pct)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    return AppendPacket(pct.GetOpcode(), pct.contents(), pct.size(), &pct);
+}
+
+int WorldSocket::AppendPacket(uint16 opcode, const char* contents, size_t size, const SharedWorldPacket* shared)
+{
     // Dump outgoing packet.
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(pct, SERVER_TO_CLIENT);
+        sPacketLog->LogPacket(opcode, (const uint8*) contents, size, SERVER_TO_CLIENT, m_Session ? m_Session->GetAccountId() : 0);
 
-    if (m_Session)
-        sLog->outTrace(LOG_FILTER_OPCODES, "S->C %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(pct.GetOpcode()).c_str());
+    if (sScriptMgr->HasServerScripts())
+    {
+        // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
+        WorldPacket pct(opcode, size);
+        if (size)
+            pct.append((const uint8*) contents, size);
+
+        sScriptMgr->OnPacketSend(this, pct);
+    }
 
-    // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
-    sScriptMgr->OnPacketSend(this, WorldPacket(pct));
+    if (m_Session)
+        TC_LOG_TRACE(LOG_FILTER_OPCODES, "S->C %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(opcode).c_str());
 
-    ServerPktHeader header(pct.size()+2, pct.GetOpcode());
+    ServerPktHeader header(size+2, opcode);
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
+    // Small shared packets are cheaper to copy than to queue as a separate block.
+    bool copy = !shared || size <= SHARED_PACKET_COPY_SIZE;
+
+    if (copy && m_OutBuffer->space() >= size + header.getHeaderLength() && msg_queue()->is_empty())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
             ACE_ASSERT (false);
 
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
+        if (size)
+            if (m_OutBuffer->copy(contents, size) == -1)
                 ACE_ASSERT (false);
     }
     else
@@ -188,12 +217,22 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         // Enqueue the packet.
         ACE_Message_Block* mb;
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+        if (shared)
+        {
+            ACE_NEW_RETURN(mb, ACE_Message_Block(header.getHeaderLength()), -1);
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+            mb->copy((char*) header.header, header.getHeaderLength());
+            mb->cont(shared->DuplicatePayload());
+        }
+        else
+        {
+            ACE_NEW_RETURN(mb, ACE_Message_Block(size + header.getHeaderLength()), -1);
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+            mb->copy((char*) header.header, header.getHeaderLength());
+
+            if (size)
+                mb->copy(contents, size);
+        }
 
         if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
@@ -381,12 +420,29 @@ int WorldSocket::handle_output_queue (GuardType& g)
         return -1;
     }
 
-    const size_t send_len = mblk->length();
+    // a queued packet is either one block or a header block followed by a shared payload
+    iovec iov[2];
+    int iovcnt = 0;
+    for (ACE_Message_Block* block = mblk; block && iovcnt < 2; block = block->cont())
+    {
+        if (!block->length())
+            continue;
+
+        iov[iovcnt].iov_base = block->rd_ptr();
+        iov[iovcnt].iov_len = block->length();
+        ++iovcnt;
+    }
+
+    const size_t send_len = mblk->total_length();
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t n = ACE_OS::sendmsg (get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
+    ssize_t n = peer().sendv (iov, iovcnt);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -408,7 +464,13 @@ int WorldSocket::handle_output_queue (GuardType& g)
     }
     else if (n < (ssize_t)send_len) //now n > 0
     {
-        mblk->rd_ptr(static_cast<size_t> (n));
+        size_t sent = static_cast<size_t> (n);
+        for (ACE_Message_Block* block = mblk; block && sent; block = block->cont())
+        {
+            size_t len = std::min(sent, block->length());
+            block->rd_ptr(len);
+            sent -= len;
+        }
 
         if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
         {
@@ -676,10 +738,10 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
     // Dump received packet.
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER);
+        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER, m_Session ? m_Session->GetAccountId() : 0);
 
     if (m_Session)
-        sLog->outTrace(LOG_FILTER_OPCODES, "C->S %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(new_pct->GetOpcode()).c_str());
+        TC_LOG_TRACE(LOG_FILTER_OPCODES, "C->S %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(new_pct->GetOpcode()).c_str());
 
     try
     {
@@ -690,14 +752,14 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
             case CMSG_AUTH_SESSION:
                 if (m_Session)
                 {
-                    sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::ProcessIncoming: received duplicate CMSG_AUTH_SESSION from %s", m_Session->GetPlayerInfo().c_str());
+                    TC_LOG_ERROR(LOG_FILTER_NETWORKIO, "WorldSocket::ProcessIncoming: received duplicate CMSG_AUTH_SESSION from %s", m_Session->GetPlayerInfo().c_str());
                     return -1;
                 }
 
                 sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
                 return HandleAuthSession (*new_pct);
             case CMSG_KEEP_ALIVE:
-                sLog->outDebug(LOG_FILTER_NETWORKIO, "%s", GetOpcodeNameForLogging(opcode).c_str());
+                TC_LOG_DEBUG(LOG_FILTER_NETWORKIO, "%s", GetOpcodeNameForLogging(opcode).c_str());
                 sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
                 if (m_Session)
                     m_Session->ResetTimeOutTime();
@@ -1027,7 +1089,7 @@ int WorldSocket::HandlePing (WorldPacket& recvPacket)
 
                 if (m_Session && AccountMgr::IsPlayerAccount(m_Session->GetSecurity()))
                 {
-                    sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::HandlePing: %s kicked for over-speed pings (address: %s)",
+                    TC_LOG_ERROR(LOG_FILTER_NETWORKIO, "WorldSocket::HandlePing: %s kicked for over-speed pings (address: %s)",
                         m_Session->GetPlayerInfo().c_str(), GetRemoteAddress().c_str());
 
                     return -1;
@@ -43,6 +43,7 @@
 
 class ACE_Message_Block;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSession;
 
 /// Handler that can communicate over stream sockets.
@@ -110,6 +111,11 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet whose payload is shared with other sockets, only the header is copied.
+        /// @param pct packet to send
+        /// @return -1 of failure
+        int SendPacket(const SharedWorldPacket& pct);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -151,6 +157,11 @@ class WorldSocket : public WorldHandler
         /// Drain the queue if its not empty.
         int handle_output_queue (GuardType& g);
 
+        /// Log, run script hooks, encrypt the header and put the packet on the buffer or the queue.
+        /// @param shared payload of a SharedWorldPacket, queued without copying (may be NULL)
+        /// @note m_OutBufferLock must be held
+        int AppendPacket (uint16 opcode, const char* contents, size_t size, const SharedWorldPacket* shared);
+
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
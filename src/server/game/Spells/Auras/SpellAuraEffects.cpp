@@ -947,7 +947,7 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
-            m_amount = newAmount;
+            _SetAmount(newAmount);
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -958,6 +958,19 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
             HandleEffect(*apptItr, handleMask, true);
 }
 
+void AuraEffect::_SetAmount(int32 amount)
+{
+    if (m_amount == amount)
+        return;
+
+    m_amount = amount;
+
+    // targets keep cached modifier totals of their registered effects
+    Aura::ApplicationMap const& applications = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator itr = applications.begin(); itr != applications.end(); ++itr)
+        itr->second->GetTarget()->_InvalidateAuraModifierTotals(GetAuraType());
+}
+
 void AuraEffect::HandleEffect(AuraApplication * aurApp, uint8 mode, bool apply)
 {
     // check if call is correct, we really don't want using bitmasks here (with 1 exception)
@@ -17,7 +17,6 @@
  */
 
 #include "stdafx.hpp"
-#include <mutex>
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "WorldPacket.h"
@@ -46,7 +45,6 @@
 #include "VMapFactory.h"
 #include "Battleground.h"
 #include "Util.h"
-#include "vmap_mutex.hpp"
 #include "TemporarySummon.h"
 #include "Vehicle.h"
 #include "SpellAuraEffects.h"
@@ -3994,8 +3992,8 @@ void Spell::SendSpellStart()
     if (m_caster->is_object_updated())
     {
         UpdateDataMapType update_players;
+        m_caster->RemoveFromObjectUpdate();
         m_caster->BuildUpdate(update_players);
-        sObjectAccessor->RemoveUpdateObject(m_caster);
         WorldPacket packet;
         for (auto &p : update_players)
         {
@@ -4849,21 +4847,15 @@ SpellCastResult Spell::CheckCast(bool strict)
             if (bg->GetStatus() == STATUS_WAIT_LEAVE)
                 return SPELL_FAILED_DONT_REPORT;
 
-    if (m_caster->GetTypeId() == TYPEID_PLAYER)
+    if (m_caster->GetTypeId() == TYPEID_PLAYER && VMAP::VMapFactory::createOrGetVMapManager()->isLineOfSightCalcEnabled())
     {
-        auto &m = *VMAP::VMapFactory::createOrGetVMapManager();
-        std::unique_lock<vmap_mutex_type> l(vmap_mutex());
-        if (m.isLineOfSightCalcEnabled())
-        {
-            l.unlock();
-            if (m_spellInfo->Attributes & SPELL_ATTR0_OUTDOORS_ONLY &&
-                    !m_caster->GetMap()->IsOutdoors(m_caster->GetPositionX(), m_caster->GetPositionY(), m_caster->GetPositionZ()))
-                return SPELL_FAILED_ONLY_OUTDOORS;
-
-            if (m_spellInfo->Attributes & SPELL_ATTR0_INDOORS_ONLY &&
-                    m_caster->GetMap()->IsOutdoors(m_caster->GetPositionX(), m_caster->GetPositionY(), m_caster->GetPositionZ()))
-                return SPELL_FAILED_ONLY_INDOORS;
-        }
+        if (m_spellInfo->Attributes & SPELL_ATTR0_OUTDOORS_ONLY &&
+                !m_caster->IsOutdoors())
+            return SPELL_FAILED_ONLY_OUTDOORS;
+
+        if (m_spellInfo->Attributes & SPELL_ATTR0_INDOORS_ONLY &&
+                m_caster->IsOutdoors())
+            return SPELL_FAILED_ONLY_INDOORS;
     }
 
     // only check at first call, Stealth auras are already removed at second call
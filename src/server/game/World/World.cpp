@@ -30,6 +30,7 @@
 #include "Opcodes.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
+#include "PacketReplay.h"
 #include "Player.h"
 #include "Vehicle.h"
 #include "SkillExtraItems.h"
@@ -124,6 +125,8 @@ World::World()
 /// World destructor
 World::~World()
 {
+    m_sessionUpdater.deactivate();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -1172,6 +1175,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_GRID_STATS] = ConfigMgr::GetBoolDefault("MapUpdate.GridStats", false);
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = ConfigMgr::GetIntDefault("SessionUpdate.Threads", 0);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1728,6 +1733,13 @@ void World::SetInitialWorldSettings()
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Starting Map System");
     sMapMgr->Initialize();
 
+    if (uint32 sessionThreads = getIntConfig(CONFIG_SESSION_UPDATE_THREADS))
+    {
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Starting %u session update threads", sessionThreads);
+        if (m_sessionUpdater.activate(sessionThreads) == -1)
+            sLog->outError(LOG_FILTER_SERVER_LOADING, "Can't start session update threads, all packets are processed by the world thread");
+    }
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2588,6 +2600,19 @@ void World::UpdateSessions(uint32 diff)
     while (addSessQueue.next(sess))
         AddSession_ (sess);
 
+    ///- Feed the captured packets of a running replay to its sessions
+    sPacketReplay->Update(diff);
+
+    ///- Let the session update threads process the packets which only need a subsystem lock
+    if (m_sessionUpdater.activated())
+    {
+        m_parallelSessions.clear();
+        for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+            m_parallelSessions.push_back(itr->second);
+
+        m_sessionUpdater.update(m_parallelSessions);
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -30,6 +30,7 @@
 #include "SharedDefines.h"
 #include "QueryResult.h"
 #include "Callback.h"
+#include "WorldSessionUpdater.h"
 
 #include <map>
 #include <set>
@@ -166,6 +167,7 @@ enum WorldBoolConfigs
     CONFIG_WARDEN_ENABLED,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_TRANSMOG_ENABLE,
+    CONFIG_MAP_UPDATE_GRID_STATS,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -297,6 +299,7 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_SESSION_UPDATE_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -774,6 +777,8 @@ class World
         uint32 m_currentTime;
 
         SessionMap m_sessions;
+        WorldSessionUpdater m_sessionUpdater;
+        std::vector<WorldSession*> m_parallelSessions;      // only used inside UpdateSessions(), kept to reuse the storage
         typedef UNORDERED_MAP<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
         uint32 m_maxActiveSessionCount;
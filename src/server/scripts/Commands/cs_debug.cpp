@@ -33,6 +33,8 @@ EndScriptData */
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
 #include "Language.h"
+#include "MapManager.h"
+#include "PacketReplay.h"
 
 #include <fstream>
 
@@ -65,6 +67,12 @@ public:
             { "spellfail",      SEC_ADMINISTRATOR,  false, &HandleDebugSendSpellFailCommand,      "", NULL },
             { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
         };
+        static ChatCommand debugReplayCommandTable[] =
+        {
+            { "start",          SEC_ADMINISTRATOR,  true,  &HandleDebugReplayStartCommand,     "", NULL },
+            { "stop",           SEC_ADMINISTRATOR,  true,  &HandleDebugReplayStopCommand,      "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                               "", NULL }
+        };
         static ChatCommand debugCommandTable[] =
         {
             { "setbit",         SEC_ADMINISTRATOR,  false, &HandleDebugSet32BitCommand,        "", NULL },
@@ -92,6 +100,11 @@ public:
             { "areatriggers",   SEC_ADMINISTRATOR,  false, &HandleDebugAreaTriggersCommand,    "", NULL },
             { "los",            SEC_MODERATOR,      false, &HandleDebugLoSCommand,             "", NULL },
             { "moveflags",      SEC_ADMINISTRATOR,  false, &HandleDebugMoveflagsCommand,       "", NULL },
+            { "mapupdate",      SEC_ADMINISTRATOR,  true,  &HandleDebugMapUpdateCommand,       "", NULL },
+            { "packetpool",     SEC_ADMINISTRATOR,  true,  &HandleDebugPacketPoolCommand,      "", NULL },
+            { "database",       SEC_ADMINISTRATOR,  true,  &HandleDebugDatabaseCommand,        "", NULL },
+            { "savestats",      SEC_ADMINISTRATOR,  true,  &HandleDebugSaveStatsCommand,       "", NULL },
+            { "replay",         SEC_ADMINISTRATOR,  true,  NULL,                               "", debugReplayCommandTable },
             { NULL,             SEC_PLAYER,         false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -1332,6 +1345,154 @@ public:
         return true;
     }
 
+    static bool HandleDebugMapUpdateCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug mapupdate [#count]
+        // per thread and slowest maps timings of the last map update tick
+        uint32 count = *args ? uint32(atoi(args)) : 10;
+
+        MapUpdaterStats const& threads = sMapMgr->GetMapUpdater()->GetLastTickStats();
+        for (uint32 i = 0; i < threads.size(); ++i)
+            handler->PSendSysMessage("Update thread %u: busy %u us, %u maps, %u stolen", i, threads[i].busyTime, threads[i].updates, threads[i].steals);
+
+        std::vector<Map*> maps;
+        sMapMgr->GetSlowestMaps(maps, count);
+        for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        {
+            Map const* map = *itr;
+            MapUpdateStats const& stats = map->GetUpdateStats();
+            handler->PSendSysMessage("Map %u instance %u (%s): %u us, sessions %u, objects %u, scripts %u, relocation %u, object updates %u",
+                map->GetId(), map->GetInstanceId(), map->GetMapName(), stats.total, stats.sessions, stats.objects, stats.scripts, stats.relocation, stats.objectUpdates);
+
+            // the three heaviest grids
+            std::vector<std::pair<uint32, uint32> > regions;
+            for (std::vector<std::pair<uint32, uint32> >::const_iterator region = stats.regions.begin(); region != stats.regions.end(); ++region)
+                regions.push_back(std::make_pair(region->second, region->first));
+            std::sort(regions.rbegin(), regions.rend());
+            for (uint32 i = 0; i < regions.size() && i < 3; ++i)
+                handler->PSendSysMessage("    grid [%u, %u]: %u us", regions[i].second / MAX_NUMBER_OF_GRIDS, regions[i].second % MAX_NUMBER_OF_GRIDS, regions[i].first);
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugPacketPoolCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        // USAGE: .debug packetpool
+        // hit rate of the pooled packet buffers per size class, summed over all threads
+        std::vector<PacketBufferPoolStats> stats;
+        PacketBufferPool::GetStats(stats);
+
+        for (std::vector<PacketBufferPoolStats>::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+        {
+            uint64 allocations = itr->hits + itr->misses;
+            if (!allocations && !itr->releases)
+                continue;
+
+            if (itr->size)
+                handler->PSendSysMessage("%5u bytes: " UI64FMTD " allocations, %.1f%% from pool, " UI64FMTD " released, " UI64FMTD " dropped",
+                    itr->size, allocations, allocations ? 100.0f * itr->hits / allocations : 0.0f, itr->releases, itr->drops);
+            else
+                handler->PSendSysMessage("larger: " UI64FMTD " allocations, " UI64FMTD " released (not pooled)", allocations, itr->releases);
+        }
+
+        return true;
+    }
+
+    static void SendDatabaseLatencies(ChatHandler* handler, char const* name, uint64 const* buckets)
+    {
+        std::ostringstream ss;
+        ss << name << ":";
+        for (uint8 i = 0; i < DATABASE_LATENCY_BUCKETS; ++i)
+        {
+            if (!buckets[i])
+                continue;
+
+            if (i + 1 < DATABASE_LATENCY_BUCKETS)
+                ss << " <" << (1 << i) << "ms: " << buckets[i];
+            else
+                ss << " slower: " << buckets[i];
+        }
+
+        handler->SendSysMessage(ss.str().c_str());
+    }
+
+    template<class T>
+    static void SendDatabaseStats(ChatHandler* handler, char const* name, DatabaseWorkerPool<T>& database)
+    {
+        DatabaseWorkerStats stats;
+        database.GetStats(stats);
+
+        handler->PSendSysMessage("%s: queued %u (max %u), " UI64FMTD " executed, " UI64FMTD " batches of " UI64FMTD " statements",
+            name, stats.queueDepth, stats.maxQueueDepth, stats.operations, stats.batches, stats.batchedStatements);
+        SendDatabaseLatencies(handler, "  wait", stats.waitTime);
+        SendDatabaseLatencies(handler, "  execute", stats.executeTime);
+    }
+
+    static bool HandleDebugDatabaseCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        // USAGE: .debug database
+        // queue depth, statement batching and latency histograms of the asynchronous database connections
+        SendDatabaseStats(handler, "World", WorldDatabase);
+        SendDatabaseStats(handler, "Character", CharacterDatabase);
+        SendDatabaseStats(handler, "Login", LoginDatabase);
+        return true;
+    }
+
+    static bool HandleDebugSaveStatsCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug savestats [$playername]
+        // statements and bytes the character saves of an online player did not write, since login
+        Player* target;
+        if (!handler->extractPlayerTarget((char*)args, &target))
+            return false;
+
+        PlayerSaveStats const& stats = target->GetSaveStats();
+        handler->PSendSysMessage("%s: %u saves queued " UI64FMTD " statements, " UI64FMTD " statements saved",
+            target->GetName().c_str(), stats.Saves, stats.Statements, stats.SkippedStatements);
+        handler->PSendSysMessage("  " UI64FMTD " of " UI64FMTD " diffed rows stored already, " UI64FMTD " bytes not written",
+            stats.SkippedRows, stats.Rows, stats.SkippedBytes);
+        return true;
+    }
+
+    static bool HandleDebugReplayStartCommand(ChatHandler* handler, char const* args)
+    {
+        // USAGE: .debug replay start <file> [speed]
+        char* fileStr = strtok((char*)args, " ");
+        if (!fileStr)
+            return false;
+
+        char* speedStr = strtok(NULL, " ");
+        float speed = speedStr ? float(atof(speedStr)) : 1.0f;
+
+        std::string error;
+        if (!sPacketReplay->Start(fileStr, speed, error))
+        {
+            handler->PSendSysMessage("Replay not started: %s", error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        PacketReplay::Stats const& stats = sPacketReplay->GetStats();
+        handler->PSendSysMessage("Replaying %u packets of %u sessions from %s, the results are written to the server log.", stats.packets, stats.sessions, fileStr);
+        return true;
+    }
+
+    static bool HandleDebugReplayStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (!sPacketReplay->IsRunning())
+        {
+            handler->SendSysMessage("No replay is running.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        sPacketReplay->Stop();
+        PacketReplay::Stats const& stats = sPacketReplay->GetStats();
+        handler->PSendSysMessage("Replay stopped after %u of %u packets in %u ticks.", stats.queued, stats.packets, stats.ticks);
+        return true;
+    }
+
     static bool HandleWPGPSCommand(ChatHandler* handler, char const* /*args*/)
     {
         Player* player = handler->GetSession()->GetPlayer();
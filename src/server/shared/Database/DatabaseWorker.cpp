@@ -15,17 +15,170 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "stdafx.hpp"
 #include "DatabaseEnv.h"
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
+#include "Timer.h"
+#include <ace/TSS_T.h>
+
+namespace
+{
+    struct ProducerIndex
+    {
+        ProducerIndex() : index(NextIndex++) {}
+
+        uint32 index;
+
+        static std::atomic<uint32> NextIndex;
+    };
+
+    std::atomic<uint32> ProducerIndex::NextIndex(0);
+
+    ACE_TSS<ProducerIndex> ProducerIndexes;
+
+    // counters with a single writer
+    inline void Increment(std::atomic<uint64>& counter, uint64 value = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+DatabaseWorkerQueue::DatabaseWorkerQueue() : _head(&_stub), _tail(&_stub), _depth(0), _maxDepth(0),
+_sleeping(false), _closed(false), _condition(_lock)
+{
+}
+
+DatabaseWorkerQueue::~DatabaseWorkerQueue()
+{
+    while (SQLOperation* op = Pop())
+        delete op;
+}
+
+void DatabaseWorkerQueue::Enqueue(SQLOperation* op)
+{
+    op->m_enqueueTime = getUSTime();
+    op->m_queueNext.store(NULL, std::memory_order_relaxed);
+
+    // counted before it is published, so the consumer never decrements below zero
+    uint32 depth = ++_depth;
+    if (depth > _maxDepth.load(std::memory_order_relaxed))
+        _maxDepth.store(depth, std::memory_order_relaxed);
+
+    SQLOperation* prev = _head.exchange(op, std::memory_order_acq_rel);
+    prev->m_queueNext.store(op, std::memory_order_release);
+
+    // pairs with the worker setting _sleeping before checking _depth a last time
+    if (_sleeping.load())
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+        _condition.signal();
+    }
+}
+
+SQLOperation* DatabaseWorkerQueue::Pop()
+{
+    SQLOperation* tail = _tail;
+    SQLOperation* next = tail->m_queueNext.load(std::memory_order_acquire);
+
+    if (tail == &_stub)
+    {
+        if (!next)
+            return NULL;
+
+        _tail = next;
+        tail = next;
+        next = next->m_queueNext.load(std::memory_order_acquire);
+    }
+
+    if (next)
+    {
+        _tail = next;
+        return tail;
+    }
+
+    // a producer has swapped the head but not linked its operation yet
+    if (tail != _head.load(std::memory_order_acquire))
+        return NULL;
+
+    // tail is the last operation, put the stub behind it so it can be handed out
+    _stub.m_queueNext.store(NULL, std::memory_order_relaxed);
+    SQLOperation* prev = _head.exchange(&_stub, std::memory_order_acq_rel);
+    prev->m_queueNext.store(&_stub, std::memory_order_release);
+
+    next = tail->m_queueNext.load(std::memory_order_acquire);
+    if (next)
+    {
+        _tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+SQLOperation* DatabaseWorkerQueue::TryDequeue()
+{
+    SQLOperation* op = Pop();
+    if (op)
+        --_depth;
+    return op;
+}
+
+SQLOperation* DatabaseWorkerQueue::Dequeue()
+{
+    for (;;)
+    {
+        if (SQLOperation* op = TryDequeue())
+            return op;
+
+        // an operation is counted but still being linked in
+        if (_depth.load())
+        {
+            ACE_OS::thr_yield();
+            continue;
+        }
+
+        TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+        _sleeping.store(true);
+        while (!_depth.load() && !_closed.load())
+            _condition.wait();
+        _sleeping.store(false);
+
+        if (!_depth.load())
+            return NULL;
+    }
+}
 
-DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
+void DatabaseWorkerQueue::Close()
+{
+    _closed.store(true);
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    _condition.broadcast();
+}
+
+uint32 DatabaseWorkerQueue::GetProducerIndex()
+{
+    return ProducerIndexes->index;
+}
+
+DatabaseWorker::DatabaseWorker(DatabaseWorkerQueue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
-m_conn(con)
+m_conn(con),
+m_batchSize(1),
+m_operations(0),
+m_batches(0),
+m_batchedStatements(0)
 {
+    for (uint8 i = 0; i < DATABASE_LATENCY_BUCKETS; ++i)
+    {
+        m_waitTime[i].store(0);
+        m_executeTime[i].store(0);
+    }
+
     /// Assign thread to task
     activate();
 }
@@ -35,18 +188,150 @@ int DatabaseWorker::svc()
     if (!m_queue)
         return -1;
 
-    SQLOperation *request = NULL;
-    while (1)
+    std::vector<SQLOperation*> batch;
+    SQLOperation* request = m_queue->Dequeue();
+    while (request)
     {
-        request = (SQLOperation*)(m_queue->dequeue());
+        uint32 batchSize = m_batchSize.load(std::memory_order_relaxed);
+        if (batchSize <= 1 || !request->IsBatchable())
+        {
+            ExecuteOperation(request);
+            request = m_queue->Dequeue();
+            continue;
+        }
+
+        // collect the one-way statements already waiting behind this one
+        batch.push_back(request);
+        request = NULL;
+        while (batch.size() < batchSize)
+        {
+            SQLOperation* next = m_queue->TryDequeue();
+            if (!next)
+                break;
+
+            if (!next->IsBatchable())
+            {
+                request = next;
+                break;
+            }
+
+            batch.push_back(next);
+        }
+
+        ExecuteBatch(batch);
+
         if (!request)
+            request = m_queue->Dequeue();
+    }
+
+    return 0;
+}
+
+void DatabaseWorker::ExecuteOperation(SQLOperation* op)
+{
+    uint64 start = getUSTime();
+    Increment(m_waitTime[GetLatencyBucket(start - op->m_enqueueTime)]);
+
+    op->SetConnection(m_conn);
+    op->call();
+
+    Increment(m_executeTime[GetLatencyBucket(getUSTime() - start)]);
+    Increment(m_operations);
+
+    delete op;
+}
+
+void DatabaseWorker::ExecuteBatch(std::vector<SQLOperation*>& batch)
+{
+    if (batch.size() == 1)
+    {
+        ExecuteOperation(batch.front());
+        batch.clear();
+        return;
+    }
+
+    uint64 start = getUSTime();
+    for (std::vector<SQLOperation*>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+    {
+        Increment(m_waitTime[GetLatencyBucket(start - (*itr)->m_enqueueTime)]);
+        (*itr)->SetConnection(m_conn);
+    }
+
+    // Statements are only committed together. On an error the whole run is rolled back and
+    // executed statement by statement, so each one fails or succeeds exactly as it would alone.
+    m_conn->BeginTransaction();
+    uint32 reconnects = m_conn->GetReconnectCount();
+
+    size_t redoFrom = 0;                                    // first statement to execute alone
+    size_t redoSkip = batch.size();                         // statement already executed alone
+    size_t i = 0;
+    for (; i < batch.size(); ++i)
+    {
+        bool executed = batch[i]->Execute();
+
+        if (m_conn->GetReconnectCount() != reconnects)
+        {
+            // the statements before were rolled back with the lost session, this one was retried alone
+            redoSkip = i;
             break;
+        }
+
+        if (!executed)
+        {
+            m_conn->RollbackTransaction();
+            break;
+        }
+    }
 
-        request->SetConnection(m_conn);
-        request->call();
+    if (i == batch.size())
+    {
+        m_conn->CommitTransaction();
+        redoFrom = batch.size();
+        if (m_conn->GetReconnectCount() == reconnects)
+        {
+            Increment(m_batches);
+            Increment(m_batchedStatements, batch.size());
+        }
+        else
+        {
+            // the server may have committed before the connection was lost, replaying could apply the statements twice
+            sLog->outError(LOG_FILTER_SQL, "DatabaseWorker: connection lost while committing %u statements, they may not have been executed.", uint32(batch.size()));
+        }
+    }
 
-        delete request;
+    for (size_t j = redoFrom; j < batch.size(); ++j)
+        if (j != redoSkip)
+            batch[j]->Execute();
+
+    uint64 perStatement = (getUSTime() - start) / batch.size();
+    for (std::vector<SQLOperation*>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+    {
+        Increment(m_executeTime[GetLatencyBucket(perStatement)]);
+        delete *itr;
     }
 
-    return 0;
+    Increment(m_operations, batch.size());
+    batch.clear();
+}
+
+uint8 DatabaseWorker::GetLatencyBucket(uint64 usec)
+{
+    uint8 bucket = 0;
+    for (uint64 limit = 1000; bucket < DATABASE_LATENCY_BUCKETS - 1 && usec >= limit; limit <<= 1)
+        ++bucket;
+    return bucket;
+}
+
+void DatabaseWorker::GetStats(DatabaseWorkerStats& stats) const
+{
+    stats.queueDepth += m_queue->GetDepth();
+    stats.maxQueueDepth = std::max(stats.maxQueueDepth, m_queue->GetMaxDepth());
+    stats.operations += m_operations.load(std::memory_order_relaxed);
+    stats.batches += m_batches.load(std::memory_order_relaxed);
+    stats.batchedStatements += m_batchedStatements.load(std::memory_order_relaxed);
+    for (uint8 i = 0; i < DATABASE_LATENCY_BUCKETS; ++i)
+    {
+        stats.waitTime[i] += m_waitTime[i].load(std::memory_order_relaxed);
+        stats.executeTime[i] += m_executeTime[i].load(std::memory_order_relaxed);
+    }
 }
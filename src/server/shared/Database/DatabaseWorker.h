@@ -15,27 +15,119 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef _WORKERTHREAD_H
 #define _WORKERTHREAD_H
 
 #include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <atomic>
+
+#include "SQLOperation.h"
 
 class MySQLConnection;
 
+enum DatabaseLatencyBuckets
+{
+    DATABASE_LATENCY_BUCKETS = 12                           // < 1 ms, < 2 ms, < 4 ms ... < 1024 ms, slower
+};
+
+struct DatabaseWorkerStats
+{
+    DatabaseWorkerStats() : queueDepth(0), maxQueueDepth(0), operations(0), batches(0), batchedStatements(0)
+    {
+        memset(waitTime, 0, sizeof(waitTime));
+        memset(executeTime, 0, sizeof(executeTime));
+    }
+
+    uint32 queueDepth;
+    uint32 maxQueueDepth;
+    uint64 operations;
+    uint64 batches;                                         // statement runs committed as one transaction
+    uint64 batchedStatements;
+    uint64 waitTime[DATABASE_LATENCY_BUCKETS];              // from enqueueing to the start of the execution
+    uint64 executeTime[DATABASE_LATENCY_BUCKETS];
+};
+
+/// Operations for one asynchronous connection.
+/// Any thread enqueues without taking a lock, only the connection's worker dequeues;
+/// the lock is only taken to put an idle worker to sleep and to wake it up.
+class DatabaseWorkerQueue
+{
+    public:
+        DatabaseWorkerQueue();
+        ~DatabaseWorkerQueue();
+
+        void Enqueue(SQLOperation* op);
+
+        /// Blocks until an operation is available. Returns NULL once the queue is closed and drained.
+        SQLOperation* Dequeue();
+
+        /// Returns NULL instead of waiting.
+        SQLOperation* TryDequeue();
+
+        void Close();
+
+        uint32 GetDepth() const { return _depth.load(std::memory_order_relaxed); }
+        uint32 GetMaxDepth() const { return _maxDepth.load(std::memory_order_relaxed); }
+
+        /// Small number identifying the calling thread, used to spread threads over the synchronous connections.
+        static uint32 GetProducerIndex();
+
+    private:
+        SQLOperation* Pop();
+
+        class QueueStub : public SQLOperation
+        {
+            bool Execute() { return true; }
+        };
+
+        std::atomic<SQLOperation*> _head;                   // last enqueued operation
+        SQLOperation* _tail;                                // next operation to dequeue, consumer only
+        QueueStub _stub;
+
+        std::atomic<uint32> _depth;
+        std::atomic<uint32> _maxDepth;
+        std::atomic<bool> _sleeping;
+        std::atomic<bool> _closed;
+
+        ACE_Thread_Mutex _lock;
+        ACE_Condition_Thread_Mutex _condition;
+};
+
 class DatabaseWorker : protected ACE_Task_Base
 {
     public:
-        DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con);
+        DatabaseWorker(DatabaseWorkerQueue* new_queue, MySQLConnection* con);
 
         ///- Inherited from ACE_Task_Base
         int svc();
         int wait() { return ACE_Task_Base::wait(); }
 
+        /// Consecutive one-way statements executed in one transaction, 1 disables batching.
+        void SetBatchSize(uint32 batchSize) { m_batchSize = batchSize; }
+
+        void GetStats(DatabaseWorkerStats& stats) const;
+
     private:
         DatabaseWorker() : ACE_Task_Base() {}
-        ACE_Activation_Queue* m_queue;
+
+        void ExecuteBatch(std::vector<SQLOperation*>& batch);
+        void ExecuteOperation(SQLOperation* op);
+
+        static uint8 GetLatencyBucket(uint64 usec);
+
+        DatabaseWorkerQueue* m_queue;
         MySQLConnection* m_conn;
+        std::atomic<uint32> m_batchSize;
+
+        // written by the worker thread only
+        std::atomic<uint64> m_operations;
+        std::atomic<uint64> m_batches;
+        std::atomic<uint64> m_batchedStatements;
+        std::atomic<uint64> m_waitTime[DATABASE_LATENCY_BUCKETS];
+        std::atomic<uint64> m_executeTime[DATABASE_LATENCY_BUCKETS];
 };
 
 #endif
@@ -19,6 +19,7 @@
 #define _DATABASEWORKERPOOL_H
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
 
 #include "Common.h"
 #include "Callback.h"
@@ -47,7 +48,9 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _nextQueue(0),
+        _freeConnectionCondition(_freeConnectionLock),
+        _freeConnectionWaiters(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
             _connections.resize(IDX_SIZE);
@@ -59,19 +62,22 @@ class DatabaseWorkerPool
         {
         }
 
-        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads)
+        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads, uint32 batch_size = 1)
         {
             bool res = true;
             _connectionInfo = MySQLConnectionInfo(infoString);
 
-            sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u.",
-                GetDatabaseName(), async_threads, synch_threads);
+            sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u, statement batch size: %u.",
+                GetDatabaseName(), async_threads, synch_threads, batch_size);
 
-            //! Open asynchronous connections (delayed operations)
+            //! Open asynchronous connections (delayed operations), each with its own queue
             _connections[IDX_ASYNC].resize(async_threads);
+            _queues.resize(async_threads);
             for (uint8 i = 0; i < async_threads; ++i)
             {
-                T* t = new T(_queue, _connectionInfo);
+                _queues[i] = new DatabaseWorkerQueue();
+                T* t = new T(_queues[i], _connectionInfo);
+                t->m_worker->SetBatchSize(batch_size);
                 res &= t->Open();
                 _connections[IDX_ASYNC][i] = t;
                 ++_connectionCount[IDX_ASYNC];
@@ -100,10 +106,10 @@ class DatabaseWorkerPool
         {
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Closing down DatabasePool '%s'.", GetDatabaseName());
 
-            //! Shuts down delaythreads for this connection pool by underlying deactivate().
-            //! The next dequeue attempt in the worker thread tasks will result in an error,
-            //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            //! Shuts down delaythreads for this connection pool. The worker thread tasks
+            //! execute what is still queued and end once their queue is empty.
+            for (size_t i = 0; i < _queues.size(); ++i)
+                _queues[i]->Close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -124,8 +130,9 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
-            delete _queue;
+            for (size_t i = 0; i < _queues.size(); ++i)
+                delete _queues[i];
+            _queues.clear();
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "All connections on DatabasePool '%s' closed.", GetDatabaseName());
         }
@@ -182,7 +189,7 @@ class DatabaseWorkerPool
 
             T* t = GetFreeConnection();
             t->Execute(sql);
-            t->Unlock();
+            ReleaseConnection(t);
         }
 
         //! Directly executes a one-way SQL operation in string format -with variable args-, that will block the calling thread until finished.
@@ -207,7 +214,7 @@ class DatabaseWorkerPool
         {
             T* t = GetFreeConnection();
             t->Execute(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
         }
 
         /**
@@ -222,7 +229,7 @@ class DatabaseWorkerPool
                 conn = GetFreeConnection();
 
             ResultSet* result = conn->Query(sql);
-            conn->Unlock();
+            ReleaseConnection(conn);
             if (!result || !result->GetRowCount())
             {
                 delete result;
@@ -272,7 +279,7 @@ class DatabaseWorkerPool
         {
             T* t = GetFreeConnection();
             PreparedResultSet* ret = t->Query(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
 
             //! Delete proxy-class. Not needed anymore
             delete stmt;
@@ -358,6 +365,7 @@ class DatabaseWorkerPool
             {
                 case 0:
                     sLog->outDebug(LOG_FILTER_SQL_DRIVER, "Transaction contains 0 queries. Not executing.");
+                    transaction->SetState(SQL_TRANSACTION_COMMITTED);
                     return;
                 case 1:
                     sLog->outDebug(LOG_FILTER_SQL_DRIVER, "Warning: Transaction only holds 1 query, consider removing Transaction context in code.");
@@ -377,7 +385,8 @@ class DatabaseWorkerPool
             MySQLConnection* con = GetFreeConnection();
             if (con->ExecuteTransaction(transaction))
             {
-                con->Unlock();      // OK, operation succesful
+                transaction->SetState(SQL_TRANSACTION_COMMITTED);
+                ReleaseConnection(con);      // OK, operation succesful
                 return;
             }
 
@@ -389,14 +398,19 @@ class DatabaseWorkerPool
                 for (uint8 i = 0; i < loopBreaker; ++i)
                 {
                     if (con->ExecuteTransaction(transaction))
-                        break;
+                    {
+                        transaction->SetState(SQL_TRANSACTION_COMMITTED);
+                        ReleaseConnection(con);
+                        return;
+                    }
                 }
             }
 
             //! Clean up now.
+            transaction->SetState(SQL_TRANSACTION_FAILED);
             transaction->Cleanup();
 
-            con->Unlock();
+            ReleaseConnection(con);
         }
 
         //! Method used to execute prepared statements in a diverse context.
@@ -453,15 +467,20 @@ class DatabaseWorkerPool
                 if (t->LockIfReady())
                 {
                     t->Ping();
-                    t->Unlock();
+                    ReleaseConnection(t);
                 }
             }
 
-            //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-            //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-            //! as the sole purpose is to prevent connections from idling.
-            for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
-                Enqueue(new PingOperation);
+            //! Every worker thread receives 1 ping operation request on its own queue
+            for (size_t i = 0; i < _queues.size(); ++i)
+                _queues[i]->Enqueue(new PingOperation);
+        }
+
+        //! Queue depths, batching and latency histograms of the asynchronous connections, summed up.
+        void GetStats(DatabaseWorkerStats& stats) const
+        {
+            for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
+                _connections[IDX_ASYNC][i]->m_worker->GetStats(stats);
         }
 
     private:
@@ -473,30 +492,82 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
+        //! Operations go to the asynchronous connection with the shortest queue, so their execution order
+        //! is not guaranteed. Operations that depend on each other must be committed as one transaction.
         void Enqueue(SQLOperation* op)
         {
-            _queue->enqueue(op);
+            size_t count = _queues.size();
+            size_t best = _nextQueue.fetch_add(1, std::memory_order_relaxed) % count;
+            uint32 bestDepth = _queues[best]->GetDepth();
+            for (size_t i = 1; i < count && bestDepth; ++i)
+            {
+                size_t index = (best + i) % count;
+                uint32 depth = _queues[index]->GetDepth();
+                if (depth < bestDepth)
+                {
+                    best = index;
+                    bestDepth = depth;
+                }
+            }
+
+            _queues[best]->Enqueue(op);
         }
 
         //! Gets a free connection in the synchronous connection pool.
-        //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
+        //! Caller MUST call ReleaseConnection(t) after touching the MySQL context to prevent deadlocks.
         T* GetFreeConnection()
         {
-            uint8 i = 0;
-            size_t num_cons = _connectionCount[IDX_SYNCH];
-            //! Block forever until a connection is free
+            if (T* t = TryGetFreeConnection())
+                return t;
+
+            //! Block until a connection is released
+            TRINITY_GUARD(ACE_Thread_Mutex, _freeConnectionLock);
+            ++_freeConnectionWaiters;
             for (;;)
             {
-                T* t = _connections[IDX_SYNCH][++i % num_cons];
-                //! Must be matched with t->Unlock() or you will get deadlocks
-                if (t->LockIfReady())
+                //! Checked again after announcing the wait, a release in between would not signal us
+                if (T* t = TryGetFreeConnection())
+                {
+                    --_freeConnectionWaiters;
                     return t;
+                }
+
+                //! The timeout only guards against a lost wakeup
+                ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(0, 10000);
+                _freeConnectionCondition.wait(&timeout);
             }
 
             //! This will be called when Celine Dion learns to sing
             return NULL;
         }
 
+        T* TryGetFreeConnection()
+        {
+            size_t num_cons = _connectionCount[IDX_SYNCH];
+            size_t start = DatabaseWorkerQueue::GetProducerIndex();
+            for (size_t i = 0; i < num_cons; ++i)
+            {
+                T* t = _connections[IDX_SYNCH][(start + i) % num_cons];
+                //! Must be matched with ReleaseConnection(t) or you will get deadlocks
+                if (t->LockIfReady())
+                    return t;
+            }
+
+            return NULL;
+        }
+
+        void ReleaseConnection(MySQLConnection* t)
+        {
+            t->Unlock();
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_freeConnectionWaiters.load())
+            {
+                TRINITY_GUARD(ACE_Thread_Mutex, _freeConnectionLock);
+                _freeConnectionCondition.signal();
+            }
+        }
+
         char const* GetDatabaseName() const
         {
             return _connectionInfo.database.c_str();
@@ -510,7 +581,11 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        std::vector<DatabaseWorkerQueue*> _queues;          //! One queue per async worker thread.
+        std::atomic<uint32>             _nextQueue;         //! Rotates the first queue looked at by Enqueue
+        ACE_Thread_Mutex                _freeConnectionLock;
+        ACE_Condition_Thread_Mutex      _freeConnectionCondition;   //! Signaled when a synchronous connection is released while someone waits
+        std::atomic<uint32>             _freeConnectionWaiters;
         std::vector< std::vector<T*> >  _connections;
         uint32                          _connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
@@ -26,7 +26,7 @@ class CharacterDatabaseConnection : public MySQLConnection
     public:
         //- Constructors for sync and async connections
         CharacterDatabaseConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) {}
-        CharacterDatabaseConnection(ACE_Activation_Queue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) {}
+        CharacterDatabaseConnection(DatabaseWorkerQueue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo) {}
 
         //- Loads database type specific prepared statements
         void DoPrepareStatements();
@@ -34,6 +34,10 @@ class CharacterDatabaseConnection : public MySQLConnection
 
 typedef DatabaseWorkerPool<CharacterDatabaseConnection> CharacterDatabaseWorkerPool;
 
+//- Rows written by each of the *_BATCH statements, see TransactionBatch.
+//- Parameters are indexed with uint8, a batch statement takes less than 256.
+#define CHARACTER_BATCH_ROWS 8
+
 enum CharacterDatabaseStatements
 {
     /*  Naming standard for defines:
@@ -140,6 +144,7 @@ enum CharacterDatabaseStatements
     CHAR_DEL_ITEM_BOP_TRADE,
     CHAR_INS_ITEM_BOP_TRADE,
     CHAR_REP_INVENTORY_ITEM,
+    CHAR_REP_INVENTORY_ITEM_BATCH,
     CHAR_REP_ITEM_INSTANCE,
     CHAR_UPD_ITEM_INSTANCE,
     CHAR_UPD_ITEM_INSTANCE_ON_LOAD,
@@ -150,6 +155,7 @@ enum CharacterDatabaseStatements
     CHAR_SEL_ACCOUNT_BY_NAME,
     CHAR_SEL_ACCOUNT_BY_GUID,
     CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES,
+    CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIME,
     CHAR_INS_ACCOUNT_INSTANCE_LOCK_TIMES,
     CHAR_SEL_CHARACTER_NAME_CLASS,
     CHAR_SEL_CHARACTER_NAME,
@@ -211,7 +217,8 @@ enum CharacterDatabaseStatements
     CHAR_INS_EQUIP_SET,
     CHAR_DEL_EQUIP_SET,
 
-    CHAR_INS_AURA,
+    CHAR_REP_AURA,
+    CHAR_REP_AURA_BATCH,
 
     CHAR_SEL_ACCOUNT_DATA,
     CHAR_REP_ACCOUNT_DATA,
@@ -383,8 +390,8 @@ enum CharacterDatabaseStatements
     CHAR_SEL_GUILD_BANK_ITEM_BY_ENTRY,
     CHAR_DEL_CHAR_ACHIEVEMENT,
     CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS,
-    CHAR_DEL_CHAR_REPUTATION_BY_FACTION,
-    CHAR_INS_CHAR_REPUTATION_BY_FACTION,
+    CHAR_REP_CHAR_REPUTATION_BY_FACTION,
+    CHAR_REP_CHAR_REPUTATION_BATCH,
     CHAR_UPD_CHAR_ARENA_POINTS,
     CHAR_DEL_ITEM_REFUND_INSTANCE,
     CHAR_INS_ITEM_REFUND_INSTANCE,
@@ -424,6 +431,7 @@ enum CharacterDatabaseStatements
     CHAR_DEL_CHARACTER,
     CHAR_DEL_CHAR_ACTION,
     CHAR_DEL_CHAR_AURA,
+    CHAR_DEL_CHAR_AURA_BY_KEY,
     CHAR_DEL_CHAR_GIFT,
     CHAR_DEL_CHAR_INSTANCE,
     CHAR_DEL_CHAR_INVENTORY,
@@ -437,6 +445,7 @@ enum CharacterDatabaseStatements
     CHAR_DEL_GUILD_EVENTLOG_BY_PLAYER,
     CHAR_DEL_GUILD_BANK_EVENTLOG_BY_PLAYER,
     CHAR_DEL_CHAR_GLYPHS,
+    CHAR_DEL_CHAR_GLYPHS_BY_SPEC,
     CHAR_DEL_CHAR_QUESTSTATUS_DAILY,
     CHAR_DEL_CHAR_TALENT,
     CHAR_DEL_CHAR_SKILLS,
@@ -454,8 +463,8 @@ enum CharacterDatabaseStatements
     CHAR_INS_CHAR_QUESTSTATUS,
     CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST,
     CHAR_DEL_CHAR_SKILL_BY_SKILL,
-    CHAR_INS_CHAR_SKILLS,
-    CHAR_UDP_CHAR_SKILLS,
+    CHAR_REP_CHAR_SKILLS,
+    CHAR_REP_CHAR_SKILLS_BATCH,
     CHAR_INS_CHAR_SPELL,
     CHAR_DEL_CHAR_STATS,
     CHAR_INS_CHAR_STATS,
@@ -25,6 +25,7 @@
 #define _MYSQLCONNECTION_H
 
 class DatabaseWorker;
+class DatabaseWorkerQueue;
 class PreparedStatement;
 class MySQLPreparedStatement;
 class PingOperation;
@@ -71,7 +72,7 @@ class MySQLConnection
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-        MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+        MySQLConnection(DatabaseWorkerQueue* queue, MySQLConnectionInfo& connInfo);   //! Constructor for asynchronous connections.
         virtual ~MySQLConnection();
 
         virtual bool Open();
@@ -95,6 +96,9 @@ class MySQLConnection
 
         uint32 GetLastError() { return mysql_errno(m_Mysql); }
 
+        //! Successful reconnects, a change means the statements of an open transaction were rolled back.
+        uint32 GetReconnectCount() const { return m_reconnectCount; }
+
     protected:
         bool LockIfReady()
         {
@@ -112,6 +116,8 @@ class MySQLConnection
         MYSQL* GetHandle()  { return m_Mysql; }
         MySQLPreparedStatement* GetPreparedStatement(uint32 index);
         void PrepareStatement(uint32 index, const char* sql, ConnectionFlags flags);
+        //! Prepares sql followed by rows copies of the placeholders of one row, e.g. "(?, ?)"
+        void PrepareBatchStatement(uint32 index, const char* sql, const char* row, uint8 rows, ConnectionFlags flags);
 
         bool PrepareStatements();
         virtual void DoPrepareStatements() = 0;
@@ -121,12 +127,13 @@ class MySQLConnection
         PreparedStatementMap                 m_queries;       //! Query storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        uint32                               m_reconnectCount;
 
     private:
         bool _HandleMySQLErrno(uint32 errNo);
 
     private:
-        ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
+        DatabaseWorkerQueue*  m_queue;                      //! Queue of this asynchronous connection.
         DatabaseWorker*       m_worker;                     //! Core worker task.
         MYSQL *               m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
@@ -86,6 +86,11 @@ void PreparedStatement::BindParameters()
     #endif
 }
 
+void PreparedStatement::appendParameters(PreparedStatement const* row)
+{
+    statement_data.insert(statement_data.end(), row->statement_data.begin(), row->statement_data.end());
+}
+
 //- Bind to buffer
 void PreparedStatement::setBool(const uint8 index, const bool value)
 {
@@ -203,6 +208,44 @@ void PreparedStatement::setNull(const uint8 index)
     statement_data[index].type = TYPE_NULL;
 }
 
+bool operator==(PreparedStatementData const& left, PreparedStatementData const& right)
+{
+    if (left.type != right.type)
+        return false;
+
+    switch (left.type)
+    {
+        case TYPE_BOOL:
+            return left.data.boolean == right.data.boolean;
+        case TYPE_UI8:
+            return left.data.ui8 == right.data.ui8;
+        case TYPE_UI16:
+            return left.data.ui16 == right.data.ui16;
+        case TYPE_UI32:
+            return left.data.ui32 == right.data.ui32;
+        case TYPE_UI64:
+            return left.data.ui64 == right.data.ui64;
+        case TYPE_I8:
+            return left.data.i8 == right.data.i8;
+        case TYPE_I16:
+            return left.data.i16 == right.data.i16;
+        case TYPE_I32:
+            return left.data.i32 == right.data.i32;
+        case TYPE_I64:
+            return left.data.i64 == right.data.i64;
+        case TYPE_FLOAT:
+            return left.data.f == right.data.f;
+        case TYPE_DOUBLE:
+            return left.data.d == right.data.d;
+        case TYPE_STRING:
+            return left.str == right.str;
+        case TYPE_NULL:
+            return true;
+    }
+
+    return false;
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MYSQL_STMT* stmt) :
 m_Mstmt(stmt),
 m_bind(NULL)
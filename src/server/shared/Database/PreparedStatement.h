@@ -66,6 +66,9 @@ struct PreparedStatementData
     std::string str;
 };
 
+//- Same type and value, for statements writing the same row
+bool operator==(PreparedStatementData const& left, PreparedStatementData const& right);
+
 //- Forward declare
 class MySQLPreparedStatement;
 
@@ -94,6 +97,10 @@ class PreparedStatement
         void setString(const uint8 index, const std::string& value);
         void setNull(const uint8 index);
 
+        std::vector<PreparedStatementData> const& GetParameters() const { return statement_data; }
+        //- Binds the parameters of row after the ones already bound, for statements writing several rows
+        void appendParameters(PreparedStatement const* row);
+
     protected:
         void BindParameters();
 
@@ -158,6 +165,7 @@ class PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute();
+        bool IsBatchable() const { return !m_has_result; }
 
     protected:
         PreparedStatement* m_stmt;
@@ -20,6 +20,7 @@
 
 #include <ace/Method_Request.h>
 #include <ace/Activation_Queue.h>
+#include <atomic>
 
 #include "QueryResult.h"
 
@@ -59,7 +60,7 @@ class MySQLConnection;
 class SQLOperation : public ACE_Method_Request
 {
     public:
-        SQLOperation(): m_conn(NULL) {};
+        SQLOperation(): m_conn(NULL), m_queueNext(NULL), m_enqueueTime(0) {};
         virtual int call()
         {
             Execute();
@@ -68,7 +69,13 @@ class SQLOperation : public ACE_Method_Request
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! One-way statement without result, may share a transaction with the statements queued next to it.
+        virtual bool IsBatchable() const { return false; }
+
         MySQLConnection* m_conn;
+
+        std::atomic<SQLOperation*> m_queueNext;             //! Link in DatabaseWorkerQueue
+        uint64 m_enqueueTime;                               //! getUSTime() when queued, for latency statistics
 };
 
 #endif
@@ -73,20 +73,69 @@ void Transaction::Cleanup()
     _cleanedUp = true;
 }
 
+TransactionBatch::TransactionBatch(SQLTransaction& trans, uint32 batchIndex, uint8 batchRows) :
+_trans(trans), _batchIndex(batchIndex), _batchRows(batchRows), _rowCount(0), _statements(0)
+{
+    _rows.reserve(batchRows);
+}
+
+void TransactionBatch::Append(PreparedStatement* row)
+{
+    _rows.push_back(row);
+    ++_rowCount;
+    if (_rows.size() < _batchRows)
+        return;
+
+    PreparedStatement* stmt = new PreparedStatement(_batchIndex);
+    for (std::vector<PreparedStatement*>::const_iterator itr = _rows.begin(); itr != _rows.end(); ++itr)
+    {
+        stmt->appendParameters(*itr);
+        delete *itr;
+    }
+
+    _rows.clear();
+    _trans->Append(stmt);
+    ++_statements;
+}
+
+void TransactionBatch::Flush()
+{
+    for (std::vector<PreparedStatement*>::const_iterator itr = _rows.begin(); itr != _rows.end(); ++itr)
+        _trans->Append(*itr);
+
+    _statements += _rows.size();
+    _rows.clear();
+}
+
+void Transaction::SetState(SQLTransactionState state)
+{
+    if (_result)
+        _result->store(state);
+}
+
 bool TransactionTask::Execute()
 {
     if (m_conn->ExecuteTransaction(m_trans))
+    {
+        m_trans->SetState(SQL_TRANSACTION_COMMITTED);
         return true;
+    }
 
     if (m_conn->GetLastError() == 1213)
     {
         uint8 loopBreaker = 5;  // Handle MySQL Errno 1213 without extending deadlock to the core itself
         for (uint8 i = 0; i < loopBreaker; ++i)
+        {
             if (m_conn->ExecuteTransaction(m_trans))
+            {
+                m_trans->SetState(SQL_TRANSACTION_COMMITTED);
                 return true;
+            }
+        }
     }
 
     // Clean up now.
+    m_trans->SetState(SQL_TRANSACTION_FAILED);
     m_trans->Cleanup();
 
     return false;
@@ -23,6 +23,17 @@
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
 
+//- Outcome of a queued transaction, known once the database thread executed it
+enum SQLTransactionState
+{
+    SQL_TRANSACTION_PENDING,
+    SQL_TRANSACTION_COMMITTED,
+    SQL_TRANSACTION_FAILED
+};
+
+//- Shared with the code that queued a transaction, holds a SQLTransactionState
+typedef Trinity::AutoPtr<std::atomic<uint8>, ACE_Thread_Mutex> SQLTransactionResult;
+
 /*! Transactions, high level class. */
 class Transaction
 {
@@ -42,16 +53,46 @@ class Transaction
 
         size_t GetSize() const { return m_queries.size(); }
 
+        //! Reports the outcome of the commit to the owner of the result, which should hold SQL_TRANSACTION_PENDING
+        void SetResult(SQLTransactionResult const& result) { _result = result; }
+
     protected:
         void Cleanup();
+        void SetState(SQLTransactionState state);
         std::list<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        SQLTransactionResult _result;
 
 };
 typedef Trinity::AutoPtr<Transaction, ACE_Thread_Mutex> SQLTransaction;
 
+/*! Appends rows bound to a single-row statement to a transaction, merged into one statement
+    per batchRows rows. The batch statement must take the columns of the single-row one
+    batchRows times. Rows are appended in order, but only when a batch is full or on Flush. */
+class TransactionBatch
+{
+    public:
+        TransactionBatch(SQLTransaction& trans, uint32 batchIndex, uint8 batchRows);
+        ~TransactionBatch() { Flush(); }
+
+        void Append(PreparedStatement* row);
+        //! Appends the rows left as single-row statements
+        void Flush();
+
+        uint32 GetRows() const { return _rowCount; }
+        uint32 GetStatements() const { return _statements; }
+
+    private:
+        SQLTransaction& _trans;
+        uint32 _batchIndex;
+        uint8 _batchRows;
+        std::vector<PreparedStatement*> _rows;
+        uint32 _rowCount;
+        uint32 _statements;
+};
+
 /*! Low level class*/
 class TransactionTask : public SQLOperation
 {
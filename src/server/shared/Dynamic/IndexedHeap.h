@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_INDEXEDHEAP_H
+#define TRINITY_INDEXEDHEAP_H
+
+#include "Define.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Trinity
+{
+    /*
+        Binary heap of pointers which remembers the position of every element, so an
+        element can be removed, or moved after its key changed, in O(log n).
+        Traits provides:
+            static bool IsBefore(T const* a, T const* b);   // a leaves the heap before b
+            static size_t& HeapIndex(T* element);           // storage of the position
+    */
+    template<class T, class Traits>
+    class IndexedHeap
+    {
+        public:
+            bool empty() const { return _heap.empty(); }
+            size_t size() const { return _heap.size(); }
+            T* top() const { return _heap.empty() ? NULL : _heap.front(); }
+            T* operator[](size_t index) const { return _heap[index]; }
+
+            bool contains(T* element) const
+            {
+                size_t index = Traits::HeapIndex(element);
+                return index < _heap.size() && _heap[index] == element;
+            }
+
+            void push(T* element)
+            {
+                Traits::HeapIndex(element) = _heap.size();
+                _heap.push_back(element);
+                siftUp(_heap.size() - 1);
+            }
+
+            void erase(T* element)
+            {
+                // move the last entry into the hole and restore the order around it
+                size_t index = Traits::HeapIndex(element);
+                T* last = _heap.back();
+                _heap.pop_back();
+                if (index < _heap.size())
+                {
+                    _heap[index] = last;
+                    Traits::HeapIndex(last) = index;
+                    siftUp(index);
+                    siftDown(Traits::HeapIndex(last));
+                }
+            }
+
+            // restores the order after the key of element changed
+            void update(T* element)
+            {
+                siftUp(Traits::HeapIndex(element));
+                siftDown(Traits::HeapIndex(element));
+            }
+
+            void clear() { _heap.clear(); }
+
+        private:
+            void siftUp(size_t index)
+            {
+                T* element = _heap[index];
+                while (index > 0)
+                {
+                    size_t parent = (index - 1) / 2;
+                    if (!Traits::IsBefore(element, _heap[parent]))
+                        break;
+
+                    _heap[index] = _heap[parent];
+                    Traits::HeapIndex(_heap[index]) = index;
+                    index = parent;
+                }
+
+                _heap[index] = element;
+                Traits::HeapIndex(element) = index;
+            }
+
+            void siftDown(size_t index)
+            {
+                T* element = _heap[index];
+                size_t const size = _heap.size();
+                while (true)
+                {
+                    size_t child = 2 * index + 1;
+                    if (child >= size)
+                        break;
+
+                    if (child + 1 < size && Traits::IsBefore(_heap[child + 1], _heap[child]))
+                        ++child;
+
+                    if (!Traits::IsBefore(_heap[child], element))
+                        break;
+
+                    _heap[index] = _heap[child];
+                    Traits::HeapIndex(_heap[index]) = index;
+                    index = child;
+                }
+
+                _heap[index] = element;
+                Traits::HeapIndex(element) = index;
+            }
+
+            std::vector<T*> _heap;
+    };
+
+    /*
+        Visits the elements of an IndexedHeap in heap order without sorting it: a node
+        becomes a candidate once its parent was visited, the candidates are kept in a
+        second, small heap. The candidate buffer is reused by the next walk, so a walker
+        kept next to the heap doesn't allocate once it has grown.
+    */
+    template<class T, class Traits>
+    class IndexedHeapWalker
+    {
+        public:
+            IndexedHeapWalker() : _heap(NULL) { }
+
+            void start(IndexedHeap<T, Traits> const& heap)
+            {
+                _heap = &heap;
+                _candidates.clear();
+                if (!heap.empty())
+                    _candidates.push_back(0);
+            }
+
+            bool done() const { return _candidates.empty(); }
+
+            // next element in heap order, only valid while the walk is not done
+            T* next()
+            {
+                CandidateOrder order(*_heap);
+                std::pop_heap(_candidates.begin(), _candidates.end(), order);
+                size_t index = _candidates.back();
+                _candidates.pop_back();
+
+                for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < _heap->size(); ++child)
+                {
+                    _candidates.push_back(child);
+                    std::push_heap(_candidates.begin(), _candidates.end(), order);
+                }
+
+                return (*_heap)[index];
+            }
+
+        private:
+            // orders heap positions so that std::push_heap/pop_heap yield the first element first
+            class CandidateOrder
+            {
+                public:
+                    explicit CandidateOrder(IndexedHeap<T, Traits> const& heap) : _heap(heap) { }
+                    bool operator() (size_t a, size_t b) const { return Traits::IsBefore(_heap[b], _heap[a]); }
+                private:
+                    IndexedHeap<T, Traits> const& _heap;
+            };
+
+            IndexedHeap<T, Traits> const* _heap;
+            std::vector<size_t> _candidates;
+    };
+}
+
+#endif
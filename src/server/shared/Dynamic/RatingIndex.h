@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_RATINGINDEX_H
+#define TRINITY_RATINGINDEX_H
+
+#include "Define.h"
+
+#include <map>
+
+namespace Trinity
+{
+    /*
+        Queued entries ordered by rating, to find the one waiting longest inside a
+        rating window in O(log n + k), k being the number of entries in the window.
+        Entries must be equality comparable and are usually iterators into the queue.
+        Traits provides:
+            static uint32 GetRating(T const& entry);
+            static uint32 GetJoinTime(T const& entry);
+    */
+    template<class T, class Traits>
+    class RatingIndex
+    {
+        public:
+            typedef std::multimap<uint32, T> StorageType;
+
+            bool empty() const { return _entries.empty(); }
+            size_t size() const { return _entries.size(); }
+
+            void insert(T const& entry)
+            {
+                _entries.insert(typename StorageType::value_type(Traits::GetRating(entry), entry));
+            }
+
+            // the rating of the entry must not have changed since it was inserted
+            void erase(T const& entry)
+            {
+                std::pair<typename StorageType::iterator, typename StorageType::iterator> range = _entries.equal_range(Traits::GetRating(entry));
+                for (typename StorageType::iterator itr = range.first; itr != range.second; ++itr)
+                {
+                    if (itr->second == entry)
+                    {
+                        _entries.erase(itr);
+                        return;
+                    }
+                }
+            }
+
+            // oldest entry with a rating in [minRating, maxRating] which skip does not reject
+            template<class Skip>
+            bool selectOldest(uint32 minRating, uint32 maxRating, Skip const& skip, T& selected) const
+            {
+                bool found = false;
+                typename StorageType::const_iterator end = _entries.upper_bound(maxRating);
+                for (typename StorageType::const_iterator itr = _entries.lower_bound(minRating); itr != end; ++itr)
+                {
+                    if (skip(itr->second))
+                        continue;
+
+                    if (!found || Traits::GetJoinTime(itr->second) < Traits::GetJoinTime(selected))
+                    {
+                        selected = itr->second;
+                        found = true;
+                    }
+                }
+
+                return found;
+            }
+
+            void clear() { _entries.clear(); }
+
+        private:
+            StorageType _entries;
+    };
+}
+
+#endif
@@ -139,6 +139,8 @@ class Appender
 
         void setLogLevel(LogLevel);
         void write(LogMessage& message);
+        // called after every batch of messages
+        virtual void flush() { }
         static const char* getLogLevelString(LogLevel level);
         static const char* getLogFilterTypeString(LogFilterType type);
 
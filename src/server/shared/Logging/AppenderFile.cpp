@@ -32,6 +32,11 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, co
 }
 
 AppenderFile::~AppenderFile()
+{
+    closeFile();
+}
+
+void AppenderFile::closeFile()
 {
     if (logfile)
     {
@@ -40,26 +45,31 @@ AppenderFile::~AppenderFile()
     }
 }
 
+// flushed once per batch by the log worker, dynamic names keep the last file open until then
 void AppenderFile::_write(LogMessage& message)
 {
     if (dynamicName)
     {
         char namebuf[TRINITY_PATH_MAX];
         snprintf(namebuf, TRINITY_PATH_MAX, filename.c_str(), message.param1.c_str());
-        logfile = OpenFile(namebuf, mode, backup);
+        if (!logfile || currentName != namebuf)
+        {
+            closeFile();
+            currentName = namebuf;
+            logfile = OpenFile(currentName, mode, backup);
+        }
     }
 
     if (logfile)
-    {
         fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
-        fflush(logfile);
+}
 
-        if (dynamicName)
-        {
-            fclose(logfile);
-            logfile = NULL;
-        }
-    }
+void AppenderFile::flush()
+{
+    if (dynamicName)
+        closeFile();
+    else if (logfile)
+        fflush(logfile);
 }
 
 FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mode, bool backup)
@@ -26,10 +26,13 @@ class AppenderFile: public Appender
         AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags);
         ~AppenderFile();
         FILE* OpenFile(std::string const& _name, std::string const& _mode, bool _backup);
+        void flush();
 
     private:
         void _write(LogMessage& message);
+        void closeFile();
         FILE* logfile;
+        std::string currentName;                            // file logfile belongs to, for dynamic names
         std::string filename;
         std::string logDir;
         std::string mode;
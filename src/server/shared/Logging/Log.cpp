@@ -24,14 +24,15 @@
 #include "AppenderConsole.h"
 #include "AppenderFile.h"
 #include "AppenderDB.h"
-#include "LogOperation.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <sstream>
 
 Log::Log() : worker(NULL)
 {
+    UpdateLogLevels();
     SetRealmID(0);
     m_logsTimestamp = "_" + GetTimestampStr();
     LoadFromConfig();
@@ -62,13 +63,24 @@ std::string GetConfigStringDefault(std::string base, const char* name, const cha
 // Returns default logger if the requested logger is not found
 Logger* Log::GetLoggerByType(LogFilterType filter)
 {
-    LoggerMap::iterator it = loggers.begin();
-    while (it != loggers.end() && it->second.getType() != filter)
-        ++it;
-
+    LoggerMap::iterator it = loggers.find(uint8(filter));
     return it == loggers.end() ? &(loggers[0]) : &(it->second);
 }
 
+// Rebuilds the lookup tables used by ShouldLog() and dispatch(), must be called whenever a logger changes
+void Log::UpdateLogLevels()
+{
+    LoggerMap::const_iterator root = loggers.find(LOG_FILTER_GENERAL);
+    uint8 rootLevel = root != loggers.end() ? uint8(root->second.getLogLevel()) : uint8(LOG_LEVEL_DISABLED);
+
+    for (uint32 type = 0; type < 256; ++type)
+    {
+        LoggerMap::iterator it = loggers.find(uint8(type));
+        m_logLevels[type] = it != loggers.end() ? uint8(it->second.getLogLevel()) : rootLevel;
+        m_loggersByType[type] = it != loggers.end() ? &it->second : (root != loggers.end() ? &loggers[LOG_FILTER_GENERAL] : NULL);
+    }
+}
+
 Appender* Log::GetAppenderByName(std::string const& name)
 {
     AppenderMap::iterator it = appenders.begin();
@@ -276,18 +288,31 @@ void Log::EnableDBAppenders()
 void Log::vlog(LogFilterType filter, LogLevel level, char const* str, va_list argptr)
 {
     char text[MAX_QUERY_LEN];
-    vsnprintf(text, MAX_QUERY_LEN, str, argptr);
-    write(new LogMessage(level, filter, text));
+    int size = vsnprintf(text, MAX_QUERY_LEN, str, argptr);
+    if (size < 0)
+        return;
+
+    write(level, filter, text, std::min(size_t(size), size_t(MAX_QUERY_LEN - 1)));
 }
 
-void Log::write(LogMessage* msg)
+void Log::write(LogLevel level, LogFilterType type, char const* text, size_t size, std::string const& param1 /*= std::string()*/)
 {
     if (worker)
-    {
-        msg->text.append("\n");
-        Logger* logger = GetLoggerByType(msg->type);
-        worker->enqueue(new LogOperation(logger, msg));
-    }
+        worker->enqueue(level, type, text, size, param1);
+}
+
+void Log::dispatch(LogMessage& msg)
+{
+    msg.text.append("\n");
+    if (Logger* logger = m_loggersByType[uint8(msg.type)])
+        logger->write(msg);
+}
+
+void Log::flush()
+{
+    for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
+        if (it->second)
+            it->second->flush();
 }
 
 std::string Log::GetTimestampStr()
@@ -321,6 +346,7 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
             return false;
 
         it->second.setLogLevel(newLevel);
+        UpdateLogLevels();
     }
     else
     {
@@ -333,21 +359,6 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
     return true;
 }
 
-bool Log::ShouldLog(LogFilterType type, LogLevel level) const
-{
-    LoggerMap::const_iterator it = loggers.find(uint8(type));
-    if (it != loggers.end())
-    {
-        LogLevel loggerLevel = it->second.getLogLevel();
-        return loggerLevel && loggerLevel <= level;
-    }
-
-    if (type != LOG_FILTER_GENERAL)
-        return ShouldLog(LOG_FILTER_GENERAL, level);
-
-    return false;
-}
-
 void Log::outTrace(LogFilterType filter, const char * str, ...)
 {
     if (!str || !ShouldLog(filter, LOG_LEVEL_TRACE))
@@ -435,13 +446,11 @@ void Log::outCharDump(char const* str, uint32 accountId, uint32 guid, char const
     ss << "== START DUMP == (account: " << accountId << " guid: " << guid << " name: " << name
        << ")\n" << str << "\n== END DUMP ==\n";
 
-    LogMessage* msg = new LogMessage(LOG_LEVEL_INFO, LOG_FILTER_PLAYER_DUMP, ss.str());
+    std::string text = ss.str();
     std::ostringstream param;
     param << guid << '_' << name;
 
-    msg->param1 = param.str();
-
-    write(msg);
+    write(LOG_LEVEL_INFO, LOG_FILTER_PLAYER_DUMP, text.c_str(), text.size(), param.str());
 }
 
 void Log::outCommand(uint32 account, const char * str, ...)
@@ -452,16 +461,16 @@ void Log::outCommand(uint32 account, const char * str, ...)
     va_list ap;
     va_start(ap, str);
     char text[MAX_QUERY_LEN];
-    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    int size = vsnprintf(text, MAX_QUERY_LEN, str, ap);
     va_end(ap);
 
-    LogMessage* msg = new LogMessage(LOG_LEVEL_INFO, LOG_FILTER_GMCOMMAND, text);
+    if (size < 0)
+        return;
 
     std::ostringstream ss;
     ss << account;
-    msg->param1 = ss.str();
 
-    write(msg);
+    write(LOG_LEVEL_INFO, LOG_FILTER_GMCOMMAND, text, std::min(size_t(size), size_t(MAX_QUERY_LEN - 1)), ss.str());
 }
 
 void Log::SetRealmID(uint32 id)
@@ -474,6 +483,7 @@ void Log::Close()
     delete worker;
     worker = NULL;
     loggers.clear();
+    UpdateLogLevels();
     for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
     {
         delete it->second;
@@ -493,4 +503,5 @@ void Log::LoadFromConfig()
             m_logsDir.push_back('/');
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    UpdateLogLevels();
 }
@@ -32,6 +32,7 @@
 class Log
 {
     friend class ACE_Singleton<Log, ACE_Thread_Mutex>;
+    friend class LogWorker;
 
     typedef std::map<uint8, Logger> LoggerMap;
 
@@ -42,7 +43,12 @@ class Log
     public:
         void LoadFromConfig();
         void Close();
-        bool ShouldLog(LogFilterType type, LogLevel level) const;
+        bool ShouldLog(LogFilterType type, LogLevel level) const
+        {
+            uint8 loggerLevel = m_logLevels[uint8(type)];
+            return loggerLevel && loggerLevel <= level;
+        }
+
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         void outTrace(LogFilterType f, char const* str, ...) ATTR_PRINTF(3,4);
@@ -61,9 +67,13 @@ class Log
 
     private:
         void vlog(LogFilterType f, LogLevel level, char const* str, va_list argptr);
-        void write(LogMessage* msg);
+        void write(LogLevel level, LogFilterType type, char const* text, size_t size, std::string const& param1 = std::string());
+        // called by the LogWorker thread only
+        void dispatch(LogMessage& msg);
+        void flush();
 
         Logger* GetLoggerByType(LogFilterType filter);
+        void UpdateLogLevels();
         Appender* GetAppenderByName(std::string const& name);
         uint8 NextAppenderId();
         void CreateAppenderFromConfig(const char* name);
@@ -80,8 +90,27 @@ class Log
 
         uint32 realm;
         LogWorker* worker;
+
+        // per filter type: level of its logger (or of the root logger if it has none) and the logger itself
+        uint8 m_logLevels[256];
+        Logger* m_loggersByType[256];
 };
 
 #define sLog ACE_Singleton<Log, ACE_Thread_Mutex>::instance()
 
+// the arguments are only evaluated if the message is going to be logged,
+// use them where building the arguments costs something (names, opcode strings)
+#define TC_LOG_MESSAGE(filter__, level__, out__, ...)   \
+    do {                                                \
+        if (sLog->ShouldLog(filter__, level__))         \
+            sLog->out__(filter__, __VA_ARGS__);         \
+    } while (0)
+
+#define TC_LOG_TRACE(filter__, ...) TC_LOG_MESSAGE(filter__, LOG_LEVEL_TRACE, outTrace, __VA_ARGS__)
+#define TC_LOG_DEBUG(filter__, ...) TC_LOG_MESSAGE(filter__, LOG_LEVEL_DEBUG, outDebug, __VA_ARGS__)
+#define TC_LOG_INFO(filter__, ...)  TC_LOG_MESSAGE(filter__, LOG_LEVEL_INFO, outInfo, __VA_ARGS__)
+#define TC_LOG_WARN(filter__, ...)  TC_LOG_MESSAGE(filter__, LOG_LEVEL_WARN, outWarn, __VA_ARGS__)
+#define TC_LOG_ERROR(filter__, ...) TC_LOG_MESSAGE(filter__, LOG_LEVEL_ERROR, outError, __VA_ARGS__)
+#define TC_LOG_FATAL(filter__, ...) TC_LOG_MESSAGE(filter__, LOG_LEVEL_FATAL, outFatal, __VA_ARGS__)
+
 #endif
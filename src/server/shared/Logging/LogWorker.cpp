@@ -17,35 +17,233 @@
 
 #include "stdafx.hpp"
 #include "LogWorker.h"
+#include "Log.h"
+#include "Common.h"
 
-LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_Thread.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
 {
-    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+    struct LogRecordHeader
+    {
+        uint64 sequence;
+        time_t time;
+        uint32 textSize;
+        uint32 paramSize;
+        uint8 level;
+        uint8 type;
+    };
+
+    // never destroyed: threads may log while static objects are destroyed, rings survive a log reload
+    ThreadRingRegistry& GetLogRings()
+    {
+        static ThreadRingRegistry* registry = new ThreadRingRegistry(LogWorker::RING_SIZE);
+        return *registry;
+    }
+
+    // published records of one ring not dispatched yet
+    struct RingCursor
+    {
+        ThreadRing* ring;
+        size_t pos;
+        size_t head;
+        LogRecordHeader header;                             // header of the record at pos
+
+        void ReadHeader() { ring->Read(pos, &header, sizeof(header)); }
+    };
+
+    bool LargeMessageSequenceLess(std::pair<uint64, LogMessage*> const& left, std::pair<uint64, LogMessage*> const& right)
+    {
+        return left.first < right.first;
+    }
+}
+
+LogWorker::LogWorker() : ThreadRingWorker(GetLogRings(), FLUSH_INTERVAL), m_largeCondition(GetMutex()), m_sequence(0), m_dropped(0), m_reportedDrops(0)
+{
+    Start();
 }
 
 LogWorker::~LogWorker()
 {
-    m_queue.deactivate();
-    wait();
+    Stop();
 }
 
-int LogWorker::enqueue(LogOperation* op)
+void LogWorker::enqueue(LogLevel level, LogFilterType type, char const* text, size_t size, std::string const& param1)
 {
-    return m_queue.enqueue(op);
+    LogRecordHeader header;
+    header.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+    header.time = time(NULL);
+    header.textSize = uint32(size);
+    header.paramSize = uint32(param1.size());
+    header.level = uint8(level);
+    header.type = uint8(type);
+
+    ThreadRingRegistry& registry = GetRegistry();
+    ThreadRing* ring = registry.GetThreadRing();
+    size_t const recordSize = sizeof(header) + size + param1.size();
+
+    // records logged by the appenders: a full ring would only be drained by this thread
+    if (registry.IsConsumerThread() && (recordSize > RING_SIZE / 2 || ring->Free() < recordSize))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (recordSize > RING_SIZE / 2)
+    {
+        // keep the order of this thread's records: everything written before must be consumed first,
+        // and the writer must have taken the message before anything written after
+        while (ring->Used())
+        {
+            if (!IsConsuming())
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            Wakeup();
+            ACE_OS::thr_yield();
+        }
+
+        LogMessage* msg = new LogMessage(level, type, std::string(text, size));
+        msg->param1 = param1;
+        msg->mtime = header.time;
+
+        TRINITY_GUARD(ACE_Thread_Mutex, GetMutex());
+        // the writer takes the queue a last time after Stop() set the shutdown flag under this lock
+        if (!IsConsuming())
+        {
+            delete msg;
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        m_largeQueue.push_back(std::make_pair(header.sequence, msg));
+        WakeupLocked();
+        while (!m_largeQueue.empty() && !IsShuttingDown())
+            m_largeCondition.wait();
+        return;
+    }
+
+    while (ring->Free() < recordSize)
+    {
+        // nothing drains the ring once the writer stopped (log reload, shutdown)
+        if (!IsConsuming())
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Wakeup();
+        ACE_OS::thr_yield();
+    }
+
+    size_t pos = ring->GetHead();
+    ring->Write(pos, &header, sizeof(header));
+    ring->Write(pos + sizeof(header), text, size);
+    ring->Write(pos + sizeof(header) + size, param1.data(), param1.size());
+    ring->Publish(pos + recordSize);
+
+    if (ring->Used() > RING_SIZE / 2)
+        Wakeup();
 }
 
-int LogWorker::svc()
+bool LogWorker::Drain(std::vector<ThreadRing*> const& rings)
 {
-    while (1)
+    std::deque<std::pair<uint64, LogMessage*> > largeQueue;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, GetMutex());
+        largeQueue.swap(m_largeQueue);
+        m_largeCondition.broadcast();
+    }
+
+    // threads may queue their large messages out of sequence
+    std::sort(largeQueue.begin(), largeQueue.end(), LargeMessageSequenceLess);
+
+    std::vector<RingCursor> cursors;
+    for (std::vector<ThreadRing*>::const_iterator itr = rings.begin(); itr != rings.end(); ++itr)
+    {
+        RingCursor cursor;
+        cursor.ring = *itr;
+        cursor.pos = cursor.ring->GetTail();
+        cursor.head = cursor.ring->GetPublishedHead();
+        if (cursor.pos < cursor.head)
+        {
+            cursor.ReadHeader();
+            cursors.push_back(cursor);
+        }
+    }
+
+    bool written = !largeQueue.empty() || !cursors.empty();
+
+    // Merge the rings and the large messages by sequence. Records published after the batch
+    // started are left for the next one, so the order is exact within a batch.
+    std::string text;
+    for (;;)
     {
-        LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
+        RingCursor* next = NULL;
+        for (std::vector<RingCursor>::iterator itr = cursors.begin(); itr != cursors.end(); ++itr)
+            if (itr->pos < itr->head && (!next || itr->header.sequence < next->header.sequence))
+                next = &*itr;
+
+        if (!largeQueue.empty() && (!next || largeQueue.front().first < next->header.sequence))
+        {
+            sLog->dispatch(*largeQueue.front().second);
+            delete largeQueue.front().second;
+            largeQueue.pop_front();
+            continue;
+        }
+
+        if (!next)
             break;
 
-        request->call();
-        delete request;
+        LogRecordHeader const& header = next->header;
+        size_t pos = next->pos + sizeof(header);
+
+        text.resize(header.textSize);
+        if (header.textSize)
+            next->ring->Read(pos, &text[0], header.textSize);
+        pos += header.textSize;
+
+        LogMessage msg(LogLevel(header.level), LogFilterType(header.type), text);
+        msg.mtime = header.time;
+        if (header.paramSize)
+        {
+            msg.param1.resize(header.paramSize);
+            next->ring->Read(pos, &msg.param1[0], header.paramSize);
+            pos += header.paramSize;
+        }
+
+        next->pos = pos;
+        if (pos < next->head)
+            next->ReadHeader();
+
+        sLog->dispatch(msg);
     }
 
-    return 0;
+    for (std::vector<RingCursor>::const_iterator itr = cursors.begin(); itr != cursors.end(); ++itr)
+        itr->ring->Consume(itr->pos);
+
+    uint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDrops)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "LogWorker: " UI64FMTD " log records dropped so far", dropped);
+        LogMessage msg(LOG_LEVEL_WARN, LOG_FILTER_GENERAL, buf);
+        msg.mtime = time(NULL);
+        sLog->dispatch(msg);
+        m_reportedDrops = dropped;
+        written = true;
+    }
+
+    return written;
+}
+
+void LogWorker::Flush()
+{
+    sLog->flush();
 }
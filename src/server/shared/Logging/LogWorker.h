@@ -18,30 +18,44 @@
 #ifndef LOGWORKER_H
 #define LOGWORKER_H
 
-#include "LogOperation.h"
+#include "Appender.h"
+#include "ThreadRing.h"
 
-#include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <atomic>
+#include <deque>
 
-class LogWorker: protected ACE_Task_Base
+/*
+    Every thread writes its log records into its own ThreadRing, a
+    LogRecordHeader followed by the text and param1, without taking a lock.
+    The writer thread wakes up every FLUSH_INTERVAL ms, or as soon as a ring
+    is half full, turns the records into LogMessages for the loggers and
+    flushes the appenders once per batch. Records that do not fit into a
+    ring (player dumps) are handed over through a locked queue. Every record
+    gets a global sequence number, the rings and the queue of a batch are
+    merged by it so the files keep the order in which records were logged.
+*/
+class LogWorker: protected ThreadRingWorker
 {
     public:
         LogWorker();
         ~LogWorker();
 
-        typedef ACE_Message_Queue_Ex<LogOperation, ACE_MT_SYNCH> LogMessageQueueType;
-
         enum
         {
-            HIGH_WATERMARK = 8 * 1024 * 1024,
-            LOW_WATERMARK  = 8 * 1024 * 1024
+            RING_SIZE      = 256 * 1024,
+            FLUSH_INTERVAL = 100                            // ms
         };
 
-        int enqueue(LogOperation *op);
-
+        void enqueue(LogLevel level, LogFilterType type, char const* text, size_t size, std::string const& param1 = std::string());
     private:
-        virtual int svc();
-        LogMessageQueueType m_queue;
+        bool Drain(std::vector<ThreadRing*> const& rings);
+        void Flush();
+
+        ACE_Condition_Thread_Mutex m_largeCondition;        // signaled when the writer took m_largeQueue
+        std::deque<std::pair<uint64, LogMessage*> > m_largeQueue;    // sequence, message
+        std::atomic<uint64> m_sequence;
+        std::atomic<uint64> m_dropped;                      // records logged by the writer into a full ring, or while it is stopped
+        uint64 m_reportedDrops;                             // writer thread only
 };
 
 #endif
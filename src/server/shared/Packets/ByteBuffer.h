@@ -23,6 +23,7 @@
 #include "Debugging/Errors.h"
 #include "Logging/Log.h"
 #include "Utilities/ByteConverter.h"
+#include "PacketBufferPool.h"
 
 class ByteBufferException
 {
@@ -547,7 +548,7 @@ class ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        std::vector<uint8, PacketBufferAllocator<uint8> > _storage;
 };
 
 template <typename T>
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "PacketBufferPool.h"
+#include "Common.h"
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <set>
+
+namespace
+{
+    typedef std::atomic<uint64> Counter;
+
+    // written only by the owning thread, read by GetStats
+    inline void Increment(Counter& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    struct PoolCounters
+    {
+        PoolCounters() : hits(0), misses(0), releases(0), drops(0) {}
+
+        Counter hits;
+        Counter misses;
+        Counter releases;
+        Counter drops;
+    };
+
+    std::atomic<uint32> SizeHints[PacketBufferPool::MAX_SIZE_HINT_OPCODE];
+
+    void AddStats(PacketBufferPoolStats& stats, PoolCounters const& counters)
+    {
+        stats.hits += counters.hits.load(std::memory_order_relaxed);
+        stats.misses += counters.misses.load(std::memory_order_relaxed);
+        stats.releases += counters.releases.load(std::memory_order_relaxed);
+        stats.drops += counters.drops.load(std::memory_order_relaxed);
+    }
+
+    struct ThreadPool
+    {
+        ThreadPool();
+        ~ThreadPool();
+
+        std::vector<void*> freeBuffers[PacketBufferPool::CLASS_COUNT];
+        PoolCounters counters[PacketBufferPool::CLASS_COUNT + 1];
+    };
+
+    struct PoolRegistry
+    {
+        ACE_Thread_Mutex lock;
+        std::set<ThreadPool*> pools;
+        PacketBufferPoolStats exitedPoolStats[PacketBufferPool::CLASS_COUNT + 1];
+        ACE_TSS<ThreadPool> threadPools;
+    };
+
+    // never destroyed and created on first use: static objects in other files may allocate
+    // buffers before this file is initialized and release them after it is destroyed
+    PoolRegistry& GetRegistry()
+    {
+        static PoolRegistry* registry = new PoolRegistry();
+        return *registry;
+    }
+
+    ThreadPool::ThreadPool()
+    {
+        for (uint8 i = 0; i < PacketBufferPool::CLASS_COUNT; ++i)
+            freeBuffers[i].reserve(PacketBufferPool::MAX_FREE_PER_CLASS);
+
+        PoolRegistry& registry = GetRegistry();
+        TRINITY_GUARD(ACE_Thread_Mutex, registry.lock);
+        registry.pools.insert(this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        for (uint8 i = 0; i < PacketBufferPool::CLASS_COUNT; ++i)
+            for (std::vector<void*>::const_iterator itr = freeBuffers[i].begin(); itr != freeBuffers[i].end(); ++itr)
+                ::operator delete(*itr);
+
+        PoolRegistry& registry = GetRegistry();
+        TRINITY_GUARD(ACE_Thread_Mutex, registry.lock);
+        registry.pools.erase(this);
+        for (uint8 i = 0; i <= PacketBufferPool::CLASS_COUNT; ++i)
+            AddStats(registry.exitedPoolStats[i], counters[i]);
+    }
+
+    inline uint8 GetSizeClass(size_t size)
+    {
+        uint8 sizeClass = 0;
+        while (sizeClass < PacketBufferPool::CLASS_COUNT && size > (size_t(1) << (PacketBufferPool::MIN_CLASS_SHIFT + sizeClass)))
+            ++sizeClass;
+        return sizeClass;
+    }
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    uint8 sizeClass = GetSizeClass(size);
+    ThreadPool* pool = GetRegistry().threadPools;
+
+    if (sizeClass == CLASS_COUNT || !pool)
+    {
+        if (pool)
+            Increment(pool->counters[CLASS_COUNT].misses);
+        return ::operator new(size);
+    }
+
+    std::vector<void*>& freeBuffers = pool->freeBuffers[sizeClass];
+    if (!freeBuffers.empty())
+    {
+        void* ptr = freeBuffers.back();
+        freeBuffers.pop_back();
+        Increment(pool->counters[sizeClass].hits);
+        return ptr;
+    }
+
+    Increment(pool->counters[sizeClass].misses);
+    return ::operator new(size_t(1) << (MIN_CLASS_SHIFT + sizeClass));
+}
+
+void PacketBufferPool::Release(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    uint8 sizeClass = GetSizeClass(size);
+    ThreadPool* pool = GetRegistry().threadPools;
+
+    if (!pool)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    Increment(pool->counters[sizeClass].releases);
+
+    if (sizeClass == CLASS_COUNT || pool->freeBuffers[sizeClass].size() >= MAX_FREE_PER_CLASS)
+    {
+        if (sizeClass != CLASS_COUNT)
+            Increment(pool->counters[sizeClass].drops);
+        ::operator delete(ptr);
+        return;
+    }
+
+    pool->freeBuffers[sizeClass].push_back(ptr);
+}
+
+size_t PacketBufferPool::GetSizeHint(uint16 opcode, size_t defaultSize)
+{
+    if (opcode >= MAX_SIZE_HINT_OPCODE)
+        return defaultSize;
+
+    // the caller may know the packet is larger than the ones seen so far
+    return std::max<size_t>(SizeHints[opcode].load(std::memory_order_relaxed), defaultSize);
+}
+
+void PacketBufferPool::RecordSize(uint16 opcode, size_t size)
+{
+    if (opcode >= MAX_SIZE_HINT_OPCODE || !size)
+        return;
+
+    // follows the largest recent packet and decays slowly, so a single huge packet is forgotten
+    uint32 hint = SizeHints[opcode].load(std::memory_order_relaxed);
+    uint32 newHint = size >= hint ? uint32(size) : hint - (hint - uint32(size)) / 16;
+    if (newHint != hint)
+        SizeHints[opcode].store(newHint, std::memory_order_relaxed);
+}
+
+void PacketBufferPool::GetStats(std::vector<PacketBufferPoolStats>& stats)
+{
+    stats.assign(CLASS_COUNT + 1, PacketBufferPoolStats());
+
+    PoolRegistry& registry = GetRegistry();
+    TRINITY_GUARD(ACE_Thread_Mutex, registry.lock);
+    for (uint8 i = 0; i <= CLASS_COUNT; ++i)
+    {
+        stats[i] = registry.exitedPoolStats[i];
+        stats[i].size = i < CLASS_COUNT ? uint32(1) << (MIN_CLASS_SHIFT + i) : 0;
+        for (std::set<ThreadPool*>::const_iterator itr = registry.pools.begin(); itr != registry.pools.end(); ++itr)
+            AddStats(stats[i], (*itr)->counters[i]);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PACKETBUFFERPOOL_H
+#define _PACKETBUFFERPOOL_H
+
+#include "Define.h"
+#include <cstddef>
+#include <vector>
+
+struct PacketBufferPoolStats
+{
+    PacketBufferPoolStats() : size(0), hits(0), misses(0), releases(0), drops(0) {}
+
+    uint32 size;                                            // buffer size of the class, 0 for buffers too large to pool
+    uint64 hits;
+    uint64 misses;
+    uint64 releases;
+    uint64 drops;                                           // released but freed because the thread's free list was full
+};
+
+/// Size classed storage for ByteBuffer/WorldPacket contents.
+/// Every thread keeps its own free lists, so recycling a buffer takes no lock;
+/// buffers released by another thread than the one allocating them just change lists.
+class PacketBufferPool
+{
+    public:
+        enum
+        {
+            MIN_CLASS_SHIFT         = 6,                    // smallest class holds 64 bytes
+            CLASS_COUNT             = 11,                   // largest class holds 64 KB
+            MAX_FREE_PER_CLASS      = 64,
+            MAX_SIZE_HINT_OPCODE    = 0x800
+        };
+
+        static void* Allocate(size_t size);
+        static void Release(void* ptr, size_t size);
+
+        /// Reserve size for a new packet of this opcode, from the sizes of the previous ones, never below defaultSize.
+        static size_t GetSizeHint(uint16 opcode, size_t defaultSize);
+        static void RecordSize(uint16 opcode, size_t size);
+
+        /// One entry per size class, followed by the unpooled large buffers.
+        static void GetStats(std::vector<PacketBufferPoolStats>& stats);
+};
+
+template <class T>
+class PacketBufferAllocator
+{
+    public:
+        typedef T value_type;
+
+        PacketBufferAllocator() { }
+        template <class U> PacketBufferAllocator(PacketBufferAllocator<U> const&) { }
+
+        T* allocate(size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+        void deallocate(T* ptr, size_t n) { PacketBufferPool::Release(ptr, n * sizeof(T)); }
+};
+
+template <class T, class U>
+inline bool operator==(PacketBufferAllocator<T> const&, PacketBufferAllocator<U> const&) { return true; }
+
+template <class T, class U>
+inline bool operator!=(PacketBufferAllocator<T> const&, PacketBufferAllocator<U> const&) { return false; }
+
+#endif
@@ -29,16 +29,23 @@ class WorldPacket : public ByteBuffer
         WorldPacket()                                       : ByteBuffer(0), m_opcode(0)
         {
         }
-        explicit WorldPacket(uint16 opcode, size_t res=200) : ByteBuffer(res), m_opcode(opcode) { }
+                                                            // reserves what previous packets of this opcode needed
+        explicit WorldPacket(uint16 opcode, size_t res=200) : ByteBuffer(PacketBufferPool::GetSizeHint(opcode, res)), m_opcode(opcode) { }
                                                             // copy constructor
         WorldPacket(const WorldPacket &packet)              : ByteBuffer(packet), m_opcode(packet.m_opcode)
         {
         }
 
+        ~WorldPacket()
+        {
+            PacketBufferPool::RecordSize(m_opcode, size());
+        }
+
         void Initialize(uint16 opcode, size_t newres=200)
         {
+            PacketBufferPool::RecordSize(m_opcode, size());
             clear();
-            _storage.reserve(newres);
+            _storage.reserve(PacketBufferPool::GetSizeHint(opcode, newres));
             m_opcode = opcode;
         }
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdafx.hpp"
+#include "ThreadRing.h"
+#include "Common.h"
+
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <algorithm>
+#include <cstring>
+
+ThreadRing::ThreadRing(size_t size) : _data(new char[size]), _size(size), _head(0), _tail(0), _orphaned(false)
+{
+}
+
+ThreadRing::~ThreadRing()
+{
+    delete[] _data;
+}
+
+void ThreadRing::Write(size_t pos, void const* src, size_t size)
+{
+    size_t offset = pos % _size;
+    size_t first = std::min(size, _size - offset);
+    memcpy(_data + offset, src, first);
+    memcpy(_data, static_cast<char const*>(src) + first, size - first);
+}
+
+void ThreadRing::Read(size_t pos, void* dst, size_t size) const
+{
+    size_t offset = pos % _size;
+    size_t first = std::min(size, _size - offset);
+    memcpy(dst, _data + offset, first);
+    memcpy(static_cast<char*>(dst) + first, _data, size - first);
+}
+
+size_t ThreadRing::GetSpan(size_t pos, size_t size, char const*& data) const
+{
+    size_t offset = pos % _size;
+    data = _data + offset;
+    return std::min(size, _size - offset);
+}
+
+ThreadRing* ThreadRingRegistry::GetThreadRing()
+{
+    Slot* slot = _slots;
+    if (!slot->ring)
+    {
+        slot->ring = new ThreadRing(_ringSize);
+
+        TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+        _rings.push_back(slot->ring);
+    }
+
+    return slot->ring;
+}
+
+void ThreadRingRegistry::GetRings(std::vector<ThreadRing*>& rings)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    for (std::vector<ThreadRing*>::iterator itr = _rings.begin(); itr != _rings.end();)
+    {
+        ThreadRing* ring = *itr;
+        if (ring->IsOrphaned() && !ring->Used())
+        {
+            delete ring;
+            itr = _rings.erase(itr);
+        }
+        else
+        {
+            rings.push_back(ring);
+            ++itr;
+        }
+    }
+}
+
+ThreadRingWorker::ThreadRingWorker(ThreadRingRegistry& registry, uint32 flushInterval)
+    : _registry(registry), _flushInterval(flushInterval), _condition(_mutex), _wakeupRequested(false),
+    _wakeup(false), _shutdown(false), _active(false)
+{
+}
+
+ThreadRingWorker::~ThreadRingWorker()
+{
+    // Drain() can't be called any more, the derived class stopped the thread
+    ASSERT(!_active);
+}
+
+bool ThreadRingWorker::Start()
+{
+    _shutdown = false;
+    _active = ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1) != -1;
+    return _active;
+}
+
+void ThreadRingWorker::Stop()
+{
+    if (!_active)
+        return;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+        _shutdown = true;
+        _condition.signal();
+    }
+
+    wait();
+    _active = false;
+}
+
+void ThreadRingWorker::Wakeup()
+{
+    if (_wakeupRequested.exchange(true))
+        return;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+    WakeupLocked();
+}
+
+void ThreadRingWorker::WakeupLocked()
+{
+    _wakeup = true;
+    _condition.signal();
+}
+
+int ThreadRingWorker::svc()
+{
+    _registry.SetConsumerThread();
+
+    std::vector<ThreadRing*> rings;
+    for (;;)
+    {
+        bool shutdown;
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+            if (!_wakeup && !_shutdown)
+            {
+                ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(0, _flushInterval * 1000);
+                _condition.wait(&timeout);
+            }
+
+            _wakeup = false;
+            shutdown = _shutdown;
+        }
+
+        _wakeupRequested.store(false);
+
+        rings.clear();
+        _registry.GetRings(rings);
+        if (Drain(rings))
+            Flush();
+
+        if (shutdown)
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADRING_H
+#define THREADRING_H
+
+#include "Define.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/TSS_T.h>
+
+#include <atomic>
+#include <vector>
+
+/*
+    Byte ring written by one thread and read by one consumer thread without
+    taking a lock. Positions count all bytes ever written or consumed, the
+    producer publishes what it wrote with Publish() and the consumer frees
+    what it read with Consume().
+*/
+class ThreadRing
+{
+    public:
+        explicit ThreadRing(size_t size);
+        ~ThreadRing();
+
+        size_t GetSize() const { return _size; }
+        size_t Used() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+        size_t Free() const { return _size - Used(); }
+
+        // owning thread
+        size_t GetHead() const { return _head.load(std::memory_order_relaxed); }
+        void Write(size_t pos, void const* src, size_t size);
+        void Publish(size_t head) { _head.store(head, std::memory_order_release); }
+
+        // consumer thread
+        size_t GetTail() const { return _tail.load(std::memory_order_relaxed); }
+        size_t GetPublishedHead() const { return _head.load(std::memory_order_acquire); }
+        void Read(size_t pos, void* dst, size_t size) const;
+        // contiguous part of the size bytes at pos, returns its length
+        size_t GetSpan(size_t pos, size_t size, char const*& data) const;
+        void Consume(size_t tail) { _tail.store(tail, std::memory_order_release); }
+
+        bool IsOrphaned() const { return _orphaned.load(std::memory_order_acquire); }
+        void SetOrphaned() { _orphaned.store(true, std::memory_order_release); }
+
+    private:
+        char* _data;
+        size_t const _size;
+        std::atomic<size_t> _head;                          // total bytes written
+        std::atomic<size_t> _tail;                          // total bytes consumed
+        std::atomic<bool> _orphaned;                        // owning thread exited, free once drained
+};
+
+/*
+    Gives every thread its own ThreadRing on first use. A ring outlives its
+    thread until the consumer emptied it, so registries are usually never
+    destroyed: threads may still write while static objects are destroyed.
+*/
+class ThreadRingRegistry
+{
+    public:
+        explicit ThreadRingRegistry(size_t ringSize) : _ringSize(ringSize) { }
+
+        ThreadRing* GetThreadRing();
+
+        // the consumer thread must never wait for space in its own ring
+        void SetConsumerThread() { _slots->consumer = true; }
+        bool IsConsumerThread() { return _slots->consumer; }
+
+        // frees the emptied rings of exited threads and returns the others
+        void GetRings(std::vector<ThreadRing*>& rings);
+
+    private:
+        struct Slot
+        {
+            Slot() : ring(NULL), consumer(false) { }
+            ~Slot() { if (ring) ring->SetOrphaned(); }
+
+            ThreadRing* ring;
+            bool consumer;
+        };
+
+        ACE_Thread_Mutex _lock;
+        std::vector<ThreadRing*> _rings;
+        ACE_TSS<Slot> _slots;
+        size_t const _ringSize;
+};
+
+/*
+    Thread emptying the rings of a registry every flushInterval ms, or as
+    soon as a producer calls Wakeup(). Derived classes consume the records in
+    Drain() and must call Stop() in their destructor.
+*/
+class ThreadRingWorker : protected ACE_Task_Base
+{
+    public:
+        // cheap if a wakeup is already pending
+        void Wakeup();
+
+    protected:
+        ThreadRingWorker(ThreadRingRegistry& registry, uint32 flushInterval);
+        virtual ~ThreadRingWorker();
+
+        bool Start();
+        void Stop();
+
+        ThreadRingRegistry& GetRegistry() { return _registry; }
+
+        // consumes the published records, returns true if anything was written
+        virtual bool Drain(std::vector<ThreadRing*> const& rings) = 0;
+        // called after a Drain() which wrote something
+        virtual void Flush() = 0;
+
+        // for state shared with producers, wake the worker up with WakeupLocked()
+        ACE_Thread_Mutex& GetMutex() { return _mutex; }
+        void WakeupLocked();
+        bool IsShuttingDown() const { return _shutdown; }
+        // false before Start() succeeded and from Stop() on, nothing consumes the rings then
+        bool IsConsuming() const { return _active && !_shutdown; }
+
+    private:
+        virtual int svc();
+
+        ThreadRingRegistry& _registry;
+        uint32 const _flushInterval;
+        ACE_Thread_Mutex _mutex;
+        ACE_Condition_Thread_Mutex _condition;
+        std::atomic<bool> _wakeupRequested;
+        bool _wakeup;
+        std::atomic<bool> _shutdown;                        // written under _mutex, read by producers without it
+        std::atomic<bool> _active;
+};
+
+#endif
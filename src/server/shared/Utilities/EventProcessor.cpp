@@ -19,9 +19,12 @@
 #include "stdafx.hpp"
 #include "EventProcessor.h"
 
+#include <algorithm>
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_sequence = 0;
     m_aborting = false;
 }
 
@@ -36,12 +39,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().time <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_events.front().event;
+        std::pop_heap(m_events.begin(), m_events.end());
+        m_events.pop_back();
 
         if (!Event->to_Abort)
         {
@@ -64,33 +67,47 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    // Abort() may add events, work on a detached queue so the one being walked never reallocates
+    EventList events;
+    do
     {
-        EventList::iterator i_old = i;
-        ++i;
+        events.swap(m_events);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        // first, abort all existing events
+        EventList::iterator kept = events.begin();
+        for (EventList::iterator i = events.begin(); i != events.end(); ++i)
         {
-            delete i_old->second;
+            i->event->to_Abort = true;
+            i->event->Abort(m_time);
+            if (force || i->event->IsDeletable())
+                delete i->event;
+            else
+                *kept++ = *i;
+        }
+        events.erase(kept, events.end());
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+        // events that can't be deleted yet stay queued, they get aborted again when due
+        if (!events.empty())
+        {
+            m_events.insert(m_events.end(), events.begin(), events.end());
+            std::make_heap(m_events.begin(), m_events.end());
+            events.clear();
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    while (force && !m_events.empty());
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    EventQueueEntry entry;
+    entry.time = e_time;
+    entry.sequence = m_sequence++;
+    entry.event = Event;
+    m_events.push_back(entry);
+    std::push_heap(m_events.begin(), m_events.end());
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -22,7 +22,7 @@
 #include <utility>
 #include "Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
@@ -49,7 +49,23 @@ class BasicEvent
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// Queued event, ordered by execution time and then by insertion so events
+// due at the same time execute in the order they were added
+struct EventQueueEntry
+{
+    uint64 time;
+    uint64 sequence;
+    BasicEvent* event;
+
+    // inverted for std::push_heap/pop_heap, which keep the largest element on top
+    bool operator<(EventQueueEntry const& right) const
+    {
+        return time != right.time ? time > right.time : sequence > right.sequence;
+    }
+};
+
+// binary min-heap kept in a vector, the storage is reused instead of allocating a node per event
+typedef std::vector<EventQueueEntry> EventList;
 
 class EventProcessor
 {
@@ -63,6 +79,7 @@ class EventProcessor
         uint64 CalculateTime(uint64 t_offset) const;
     protected:
         uint64 m_time;
+        uint64 m_sequence;
         EventList m_events;
         bool m_aborting;
 };
@@ -42,6 +42,15 @@ inline uint32 GetMSTimeDiffToNow(uint32 oldMSTime)
     return getMSTimeDiff(oldMSTime, getMSTime());
 }
 
+// microseconds since application start, for profiling counters
+inline uint64 getUSTime()
+{
+    static const ACE_Time_Value ApplicationStartTime = ACE_OS::gettimeofday();
+    ACE_UINT64 usec;
+    (ACE_OS::gettimeofday() - ApplicationStartTime).to_usec(usec);
+    return uint64(usec);
+}
+
 struct IntervalTimer
 {
     public:
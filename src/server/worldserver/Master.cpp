@@ -357,6 +357,7 @@ bool Master::_StartDB()
 
     std::string dbstring;
     uint8 async_threads, synch_threads;
+    uint32 batch_size;
 
     dbstring = ConfigMgr::GetStringDefault("WorldDatabaseInfo", "");
     if (dbstring.empty())
@@ -374,8 +375,9 @@ bool Master::_StartDB()
     }
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("WorldDatabase.SynchThreads", 1));
+    batch_size = uint32(ConfigMgr::GetIntDefault("WorldDatabase.BatchSize", 1));
     ///- Initialise the world database
-    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads, batch_size))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to world database %s", dbstring.c_str());
         return false;
@@ -399,8 +401,9 @@ bool Master::_StartDB()
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("CharacterDatabase.SynchThreads", 2));
 
+    batch_size = uint32(ConfigMgr::GetIntDefault("CharacterDatabase.BatchSize", 32));
     ///- Initialise the Character database
-    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads, batch_size))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to Character database %s", dbstring.c_str());
         return false;
@@ -423,8 +426,9 @@ bool Master::_StartDB()
     }
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("LoginDatabase.SynchThreads", 1));
+    batch_size = uint32(ConfigMgr::GetIntDefault("LoginDatabase.BatchSize", 32));
     ///- Initialise the login database
-    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads, batch_size))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to login database %s", dbstring.c_str());
         return false;
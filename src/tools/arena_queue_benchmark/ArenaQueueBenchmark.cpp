@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Offline benchmark of rated arena matchmaking.
+ *
+ * Teams with a normally distributed matchmaker rating join the alliance and
+ * horde queues of one arena bracket at a fixed rate. Every join schedules a
+ * queue update with the rating of the joining team, and every
+ * Arena.RatedUpdateTimer a periodic update uses the rating of the team that
+ * waits longest, like BattlegroundMgr::Update does. An update matches at most
+ * one pair of teams inside Arena.MaxRatingDifference, or with any team once
+ * its rating is discarded after Arena.RatingDiscardTimer.
+ * The same updates run against two queues:
+ * - the old one, scanning the faction queues in join order;
+ * - the rating index BattlegroundQueue uses now.
+ * Both must match the same teams, mismatches are reported. Join times are
+ * distinct, teams which joined at the same time may be matched in a different
+ * order otherwise. The workload only depends on the seed.
+ *
+ * Usage: arenaqueuebenchmark [joins per minute] [minutes] [max rating difference] [seed]
+ */
+
+#include "Define.h"
+#include "Dynamic/RatingIndex.h"
+
+#include <ace/OS_NS_sys_time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+namespace
+{
+    uint32 const TickTime           = 1000;            // ms of simulated time per tick
+    uint32 const RatingDiscardTimer = 600000;          // Arena.RatingDiscardTimer default
+    uint32 const RatedUpdateTimer   = 5000;            // Arena.RatedUpdateTimer default
+    uint32 const MeanRating         = 1500;
+    uint32 const RatingDeviation    = 300;
+    uint32 const MaxRating          = 3500;
+
+    enum Faction
+    {
+        FACTION_ALLIANCE,
+        FACTION_HORDE,
+        FACTION_COUNT
+    };
+
+    uint64 GetTime()
+    {
+        ACE_Time_Value now = ACE_OS::gettimeofday();
+        ACE_UINT64 usec;
+        now.to_usec(usec);
+        return usec;
+    }
+
+    // Small LCG, the workload must not depend on the server random generator
+    class BenchmarkRandom
+    {
+        public:
+            explicit BenchmarkRandom(uint32 seed) : _state(seed) { }
+
+            uint32 Next(uint32 max)
+            {
+                _state = _state * 1103515245 + 12345;
+                return ((_state >> 16) & 0x7FFF) % max;
+            }
+
+            // sum of twelve uniform values, close enough to a normal distribution
+            uint32 NextRating()
+            {
+                int32 sum = 0;
+                for (uint8 i = 0; i < 12; ++i)
+                    sum += int32(Next(1000));
+
+                int32 rating = int32(MeanRating) + (sum - 6000) * int32(RatingDeviation) / 1000;
+                return uint32(std::min(std::max(rating, 0), int32(MaxRating)));
+            }
+
+        private:
+            uint32 _state;
+    };
+
+    struct QueuedTeam
+    {
+        QueuedTeam(uint32 id, uint32 rating, uint32 joinTime, uint32 faction) : Id(id), Rating(rating), JoinTime(joinTime), Faction(faction) { }
+
+        uint32 Id;                                     // doubles as arena team id
+        uint32 Rating;
+        uint32 JoinTime;
+        uint32 Faction;
+    };
+
+    typedef std::list<QueuedTeam*> TeamQueue;
+
+    struct QueueOp
+    {
+        QueueOp(QueuedTeam* team, uint32 now) : Team(team), Now(now) { }
+
+        QueuedTeam* Team;                              // joining team, NULL for a periodic update
+        uint32 Now;
+    };
+
+    struct Match
+    {
+        Match(uint32 now, QueuedTeam const* alliance, QueuedTeam const* horde) : Now(now)
+        {
+            Teams[FACTION_ALLIANCE] = alliance;
+            Teams[FACTION_HORDE] = horde;
+        }
+
+        bool operator==(Match const& other) const
+        {
+            return Teams[FACTION_ALLIANCE] == other.Teams[FACTION_ALLIANCE] && Teams[FACTION_HORDE] == other.Teams[FACTION_HORDE];
+        }
+
+        uint32 Now;
+        QueuedTeam const* Teams[FACTION_COUNT];
+    };
+
+    // rating around which a periodic update searches, see BattlegroundQueue::BattlegroundQueueUpdate
+    bool GetFrontRating(TeamQueue const* queues, uint32& rating)
+    {
+        QueuedTeam const* front = NULL;
+        for (uint8 i = 0; i < FACTION_COUNT; ++i)
+            if (!queues[i].empty() && (!front || queues[i].front()->JoinTime < front->JoinTime))
+                front = queues[i].front();
+
+        if (!front)
+            return false;
+
+        rating = front->Rating;
+        return true;
+    }
+
+    // Queue as BattlegroundQueue scanned it before the rating index
+    class ScanQueue
+    {
+        public:
+            void Apply(QueueOp const& op, uint32 maxRatingDifference, std::vector<Match>& matches)
+            {
+                uint32 rating = 0;
+                if (op.Team)
+                {
+                    _queues[op.Team->Faction].push_back(op.Team);
+                    rating = op.Team->Rating;
+                }
+                else if (!GetFrontRating(_queues, rating))
+                    return;
+
+                uint32 minRating = rating <= maxRatingDifference ? 0 : rating - maxRatingDifference;
+                uint32 maxRating = rating + maxRatingDifference;
+                uint32 discardTime = op.Now - RatingDiscardTimer;
+
+                TeamQueue::iterator teams[FACTION_COUNT];
+                uint8 found = 0;
+                uint8 faction = 0;
+                for (uint8 i = 0; i < FACTION_COUNT; ++i)
+                {
+                    for (TeamQueue::iterator itr = _queues[i].begin(); itr != _queues[i].end(); ++itr)
+                    {
+                        if (IsSelectable(*itr, minRating, maxRating, discardTime))
+                        {
+                            teams[found++] = itr;
+                            faction = i;
+                            break;
+                        }
+                    }
+                }
+
+                if (!found)
+                    return;
+
+                if (found == 1)
+                {
+                    for (TeamQueue::iterator itr = teams[0]; itr != _queues[faction].end(); ++itr)
+                    {
+                        if (IsSelectable(*itr, minRating, maxRating, discardTime) && (*itr)->Id != (*teams[0])->Id)
+                        {
+                            teams[found++] = itr;
+                            break;
+                        }
+                    }
+                }
+
+                if (found != 2)
+                    return;
+
+                matches.push_back(Match(op.Now, *teams[FACTION_ALLIANCE], *teams[FACTION_HORDE]));
+                for (uint8 i = 0; i < FACTION_COUNT; ++i)
+                    _queues[(*teams[i])->Faction].erase(teams[i]);
+            }
+
+            size_t GetQueuedCount() const { return _queues[FACTION_ALLIANCE].size() + _queues[FACTION_HORDE].size(); }
+
+        private:
+            static bool IsSelectable(QueuedTeam const* team, uint32 minRating, uint32 maxRating, uint32 discardTime)
+            {
+                return (team->Rating >= minRating && team->Rating <= maxRating) || team->JoinTime < discardTime;
+            }
+
+            TeamQueue _queues[FACTION_COUNT];
+    };
+
+    struct TeamOrder
+    {
+        static uint32 GetRating(TeamQueue::iterator const& itr) { return (*itr)->Rating; }
+        static uint32 GetJoinTime(TeamQueue::iterator const& itr) { return (*itr)->JoinTime; }
+    };
+
+    class TeamSkip
+    {
+        public:
+            explicit TeamSkip(QueuedTeam const* opponent) : _opponent(opponent) { }
+            bool operator() (TeamQueue::iterator const& itr) const { return _opponent && (*itr)->Id == _opponent->Id; }
+        private:
+            QueuedTeam const* _opponent;
+    };
+
+    // Queue as BattlegroundQueue keeps it now
+    class IndexedQueue
+    {
+        public:
+            void Apply(QueueOp const& op, uint32 maxRatingDifference, std::vector<Match>& matches)
+            {
+                uint32 rating = 0;
+                if (op.Team)
+                {
+                    _queues[op.Team->Faction].push_back(op.Team);
+                    _index[op.Team->Faction].insert(--_queues[op.Team->Faction].end());
+                    rating = op.Team->Rating;
+                }
+                else if (!GetFrontRating(_queues, rating))
+                    return;
+
+                uint32 minRating = rating <= maxRatingDifference ? 0 : rating - maxRatingDifference;
+                uint32 maxRating = rating + maxRatingDifference;
+                uint32 discardTime = op.Now - RatingDiscardTimer;
+
+                TeamQueue::iterator teams[FACTION_COUNT];
+                uint8 found = 0;
+                for (uint8 i = 0; i < FACTION_COUNT; ++i)
+                    if (Select(i, minRating, maxRating, discardTime, NULL, teams[found]))
+                        ++found;
+
+                if (!found)
+                    return;
+
+                if (found == 1 && Select((*teams[0])->Faction, minRating, maxRating, discardTime, *teams[0], teams[found]))
+                    ++found;
+
+                if (found != 2)
+                    return;
+
+                matches.push_back(Match(op.Now, *teams[FACTION_ALLIANCE], *teams[FACTION_HORDE]));
+                for (uint8 i = 0; i < FACTION_COUNT; ++i)
+                {
+                    uint32 faction = (*teams[i])->Faction;
+                    _index[faction].erase(teams[i]);
+                    _queues[faction].erase(teams[i]);
+                }
+            }
+
+            size_t GetQueuedCount() const { return _queues[FACTION_ALLIANCE].size() + _queues[FACTION_HORDE].size(); }
+
+        private:
+            // same as BattlegroundQueue::SelectRatedGroup, without invited teams
+            bool Select(uint32 faction, uint32 minRating, uint32 maxRating, uint32 discardTime, QueuedTeam const* opponent, TeamQueue::iterator& selected)
+            {
+                TeamSkip skip(opponent);
+                for (TeamQueue::iterator itr = _queues[faction].begin(); itr != _queues[faction].end(); ++itr)
+                {
+                    if (skip(itr))
+                        continue;
+
+                    if ((*itr)->JoinTime < discardTime)
+                    {
+                        selected = itr;
+                        return true;
+                    }
+                    break;
+                }
+
+                return _index[faction].selectOldest(minRating, maxRating, skip, selected);
+            }
+
+            TeamQueue _queues[FACTION_COUNT];
+            Trinity::RatingIndex<TeamQueue::iterator, TeamOrder> _index[FACTION_COUNT];
+    };
+}
+
+int main(int argc, char** argv)
+{
+    uint32 joinsPerMinute = argc > 1 ? uint32(atoi(argv[1])) : 600;
+    uint32 minutes = argc > 2 ? uint32(atoi(argv[2])) : 60;
+    uint32 maxRatingDifference = argc > 3 ? uint32(atoi(argv[3])) : 150;
+    uint32 seed = argc > 4 ? uint32(atoi(argv[4])) : 1;
+
+    if (!joinsPerMinute || joinsPerMinute > 60 * TickTime || !minutes)
+    {
+        printf("Usage: %s [joins per minute] [minutes] [max rating difference] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    BenchmarkRandom rand(seed);
+    std::vector<QueuedTeam> teams;
+    teams.reserve(size_t(joinsPerMinute) * minutes);
+    ScanQueue scanQueue;
+    IndexedQueue indexedQueue;
+    std::vector<QueueOp> ops;
+    std::vector<Match> scanMatches, indexedMatches;
+
+    uint64 scanTime = 0, indexedTime = 0, scanMax = 0, indexedMax = 0;
+    uint64 updates = 0, matchCount = 0, mismatches = 0, discardedMatches = 0;
+    uint64 totalWait = 0, maxWait = 0, totalDifference = 0, maxDifference = 0;
+    size_t maxQueued = 0;
+
+    // start once the discard timer passed, getMSTime() - RatingDiscardTimer would discard every rating otherwise
+    uint32 now = RatingDiscardTimer;
+    uint32 pendingJoins = 0;
+    uint32 nextRatedUpdate = RatedUpdateTimer;
+    uint32 ticks = minutes * 60000 / TickTime;
+
+    for (uint32 tick = 0; tick < ticks; ++tick, now += TickTime)
+    {
+        ops.clear();
+
+        pendingJoins += joinsPerMinute * TickTime;
+        uint32 joins = pendingJoins / 60000;
+        pendingJoins %= 60000;
+        for (uint32 i = 0; i < joins; ++i)
+        {
+            uint32 joinTime = now + i * TickTime / joins;
+            teams.push_back(QueuedTeam(uint32(teams.size()) + 1, rand.NextRating(), joinTime, rand.Next(FACTION_COUNT)));
+            ops.push_back(QueueOp(&teams.back(), joinTime));
+        }
+
+        if (nextRatedUpdate <= TickTime)
+        {
+            ops.push_back(QueueOp(NULL, now + TickTime - 1));
+            nextRatedUpdate = RatedUpdateTimer;
+        }
+        else
+            nextRatedUpdate -= TickTime;
+
+        scanMatches.clear();
+        uint64 start = GetTime();
+        for (std::vector<QueueOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            scanQueue.Apply(*itr, maxRatingDifference, scanMatches);
+        uint64 elapsed = GetTime() - start;
+        scanTime += elapsed;
+        scanMax = std::max(scanMax, elapsed);
+
+        indexedMatches.clear();
+        start = GetTime();
+        for (std::vector<QueueOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            indexedQueue.Apply(*itr, maxRatingDifference, indexedMatches);
+        elapsed = GetTime() - start;
+        indexedTime += elapsed;
+        indexedMax = std::max(indexedMax, elapsed);
+
+        updates += ops.size();
+        if (scanMatches.size() != indexedMatches.size() || !std::equal(scanMatches.begin(), scanMatches.end(), indexedMatches.begin()))
+            ++mismatches;
+
+        for (std::vector<Match>::const_iterator itr = indexedMatches.begin(); itr != indexedMatches.end(); ++itr)
+        {
+            ++matchCount;
+            for (uint8 i = 0; i < FACTION_COUNT; ++i)
+            {
+                uint64 wait = itr->Now - itr->Teams[i]->JoinTime;
+                totalWait += wait;
+                maxWait = std::max(maxWait, wait);
+            }
+
+            uint32 a = itr->Teams[FACTION_ALLIANCE]->Rating, h = itr->Teams[FACTION_HORDE]->Rating;
+            uint64 difference = a > h ? a - h : h - a;
+            totalDifference += difference;
+            maxDifference = std::max(maxDifference, difference);
+            if (std::min(itr->Teams[FACTION_ALLIANCE]->JoinTime, itr->Teams[FACTION_HORDE]->JoinTime) < itr->Now - RatingDiscardTimer)
+                ++discardedMatches;
+        }
+
+        maxQueued = std::max(maxQueued, indexedQueue.GetQueuedCount());
+    }
+
+    printf("joins per minute %u, minutes %u, max rating difference %u, seed %u\n", joinsPerMinute, minutes, maxRatingDifference, seed);
+    printf("teams joined " SIZEFMTD ", queue updates " UI64FMTD ", still queued " SIZEFMTD ", max queued " SIZEFMTD "\n",
+        teams.size(), updates, indexedQueue.GetQueuedCount(), maxQueued);
+    printf("matches " UI64FMTD ", wait average %.1f s, max %.1f s\n", matchCount,
+        matchCount ? double(totalWait) / (2 * matchCount) / 1000.0 : 0.0, double(maxWait) / 1000.0);
+    printf("rating difference average %.1f, max " UI64FMTD ", matches with a discarded rating " UI64FMTD "\n",
+        matchCount ? double(totalDifference) / matchCount : 0.0, maxDifference, discardedMatches);
+    printf("queue scan: average %.3f us per update, max " UI64FMTD " us per tick\n", updates ? double(scanTime) / updates : 0.0, scanMax);
+    printf("rating index: average %.3f us per update, max " UI64FMTD " us per tick\n", updates ? double(indexedTime) / updates : 0.0, indexedMax);
+    printf("ticks with mismatching matches: " UI64FMTD "\n", mismatches);
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Offline benchmark of the EventProcessor under a combat-like event mix.
+ *
+ * Every unit owns an EventProcessor, updated once per map tick. Units start
+ * casts which re-add themselves every update until the cast time passed,
+ * like SpellEvent does, and launch a delayed missile event when done. Casts
+ * get interrupted (to_Abort), creatures queue assist and despawn delay
+ * events, and dying units kill all their events.
+ * The same operations run against two processors:
+ * - the old one, a std::multimap keyed by execution time;
+ * - the vector-backed binary heap EventProcessor uses now.
+ * Both must execute the same events at the same times in the same order,
+ * mismatches are reported. The workload only depends on the seed.
+ *
+ * Usage: eventprocessorbenchmark [units] [ticks] [tick time] [seed]
+ */
+
+#include "Define.h"
+#include "EventProcessor.h"
+
+#include <ace/OS_NS_sys_time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+namespace
+{
+    uint32 const CastChance     = 40;                      // per mille of idle units starting a cast each tick
+    uint32 const InterruptChance = 30;                     // per mille of casting units interrupted each tick
+    uint32 const AssistChance   = 5;                       // per mille of units queueing an assist event each tick
+    uint32 const DespawnChance  = 2;                       // per mille of units queueing a despawn delay event each tick
+    uint32 const DeathChance    = 1;                       // per mille of units dying each tick
+    uint32 const MaxCastTime    = 3000;
+    uint32 const MaxMissileTime = 1500;
+
+    uint64 GetTime()
+    {
+        ACE_Time_Value now = ACE_OS::gettimeofday();
+        ACE_UINT64 usec;
+        now.to_usec(usec);
+        return usec;
+    }
+
+    // Small LCG, the workload must not depend on the server random generator
+    class BenchmarkRandom
+    {
+        public:
+            explicit BenchmarkRandom(uint32 seed) : _state(seed) { }
+
+            uint32 Next(uint32 max)
+            {
+                _state = _state * 1103515245 + 12345;
+                return ((_state >> 16) & 0x7FFF) % max;
+            }
+
+        private:
+            uint32 _state;
+    };
+
+    // EventProcessor as it was before the heap
+    class MultimapEventProcessor
+    {
+        public:
+            typedef std::multimap<uint64, BasicEvent*> EventList;
+
+            MultimapEventProcessor() : m_time(0), m_aborting(false) { }
+            ~MultimapEventProcessor() { KillAllEvents(true); }
+
+            void Update(uint32 p_time)
+            {
+                m_time += p_time;
+
+                EventList::iterator i;
+                while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+                {
+                    BasicEvent* Event = i->second;
+                    m_events.erase(i);
+
+                    if (!Event->to_Abort)
+                    {
+                        if (Event->Execute(m_time, p_time))
+                            delete Event;
+                    }
+                    else
+                    {
+                        Event->Abort(m_time);
+                        delete Event;
+                    }
+                }
+            }
+
+            void KillAllEvents(bool force)
+            {
+                m_aborting = true;
+
+                for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+                {
+                    EventList::iterator i_old = i;
+                    ++i;
+
+                    i_old->second->to_Abort = true;
+                    i_old->second->Abort(m_time);
+                    if (force || i_old->second->IsDeletable())
+                    {
+                        delete i_old->second;
+
+                        if (!force)
+                            m_events.erase(i_old);
+                    }
+                }
+
+                if (force)
+                    m_events.clear();
+            }
+
+            void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true)
+            {
+                if (set_addtime) Event->m_addTime = m_time;
+                Event->m_execTime = e_time;
+                m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+            }
+
+            uint64 CalculateTime(uint64 t_offset) const { return m_time + t_offset; }
+
+        private:
+            uint64 m_time;
+            EventList m_events;
+            bool m_aborting;
+    };
+
+    // what the events did, both processors must produce the same trace
+    struct EventTrace
+    {
+        EventTrace() : Hash(0), Executions(0), Aborts(0) { }
+
+        void Record(uint32 id, uint64 time)
+        {
+            Hash = (Hash ^ (uint64(id) << 32 | uint32(time))) * 1099511628211ULL;
+            ++Executions;
+        }
+
+        uint64 Hash;
+        uint64 Executions;
+        uint64 Aborts;
+    };
+
+    template<class Processor>
+    struct BenchmarkUnit
+    {
+        BenchmarkUnit() : CurrentCast(NULL) { }
+
+        BasicEvent* CurrentCast;                           // declared first, the events clear it when destroyed
+        Processor Events;
+    };
+
+    template<class Processor>
+    class TracedEvent : public BasicEvent
+    {
+        public:
+            TracedEvent(EventTrace& trace, uint32 id) : _trace(trace), _id(id) { }
+
+            bool Execute(uint64 e_time, uint32 /*p_time*/)
+            {
+                _trace.Record(_id, e_time);
+                return true;
+            }
+
+            void Abort(uint64 /*e_time*/) { ++_trace.Aborts; }
+
+        protected:
+            EventTrace& _trace;
+            uint32 _id;
+    };
+
+    // spell cast: re-added every update until the cast time passed, then launches a missile
+    template<class Processor>
+    class CastEvent : public TracedEvent<Processor>
+    {
+        public:
+            CastEvent(BenchmarkUnit<Processor>& unit, EventTrace& trace, uint32 id, uint64 finishTime)
+                : TracedEvent<Processor>(trace, id), _unit(unit), _finishTime(finishTime) { }
+
+            bool Execute(uint64 e_time, uint32 p_time)
+            {
+                if (e_time < _finishTime)
+                {
+                    _unit.Events.AddEvent(this, e_time + 1, false);
+                    return false;
+                }
+
+                TracedEvent<Processor>::Execute(e_time, p_time);
+                if (_unit.CurrentCast == this)
+                    _unit.CurrentCast = NULL;
+                _unit.Events.AddEvent(new TracedEvent<Processor>(this->_trace, this->_id), _unit.Events.CalculateTime(this->_id % MaxMissileTime));
+                return true;
+            }
+
+            void Abort(uint64 e_time)
+            {
+                TracedEvent<Processor>::Abort(e_time);
+                if (_unit.CurrentCast == this)
+                    _unit.CurrentCast = NULL;
+            }
+
+        private:
+            BenchmarkUnit<Processor>& _unit;
+            uint64 _finishTime;
+    };
+
+    enum EventOpType
+    {
+        EVENT_OP_CAST,
+        EVENT_OP_INTERRUPT,
+        EVENT_OP_DELAYED,
+        EVENT_OP_DEATH,
+        EVENT_OP_UPDATE
+    };
+
+    struct EventOp
+    {
+        EventOp(EventOpType type, uint32 unit, uint32 id, uint32 delay) : Type(type), Unit(unit), Id(id), Delay(delay) { }
+
+        EventOpType Type;
+        uint32 Unit;
+        uint32 Id;
+        uint32 Delay;
+    };
+
+    template<class Processor>
+    class EventWorld
+    {
+        public:
+            explicit EventWorld(uint32 units) : _units(units) { }
+
+            void Apply(EventOp const& op, uint32 tickTime)
+            {
+                BenchmarkUnit<Processor>& unit = _units[op.Unit];
+                switch (op.Type)
+                {
+                    case EVENT_OP_CAST:
+                        if (!unit.CurrentCast)
+                        {
+                            unit.CurrentCast = new CastEvent<Processor>(unit, _trace, op.Id, unit.Events.CalculateTime(op.Delay));
+                            unit.Events.AddEvent(unit.CurrentCast, unit.Events.CalculateTime(1));
+                        }
+                        break;
+                    case EVENT_OP_INTERRUPT:
+                        if (unit.CurrentCast)
+                        {
+                            unit.CurrentCast->to_Abort = true;
+                            unit.CurrentCast = NULL;
+                        }
+                        break;
+                    case EVENT_OP_DELAYED:
+                        unit.Events.AddEvent(new TracedEvent<Processor>(_trace, op.Id), unit.Events.CalculateTime(op.Delay));
+                        break;
+                    case EVENT_OP_DEATH:
+                        unit.Events.KillAllEvents(false);
+                        break;
+                    case EVENT_OP_UPDATE:
+                        unit.Events.Update(tickTime);
+                        break;
+                }
+            }
+
+            EventTrace const& GetTrace() const { return _trace; }
+
+        private:
+            EventTrace _trace;
+            std::vector<BenchmarkUnit<Processor> > _units;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    uint32 units = argc > 1 ? uint32(atoi(argv[1])) : 2000;
+    uint32 ticks = argc > 2 ? uint32(atoi(argv[2])) : 10000;
+    uint32 tickTime = argc > 3 ? uint32(atoi(argv[3])) : 50;
+    uint32 seed = argc > 4 ? uint32(atoi(argv[4])) : 1;
+
+    if (!units || !tickTime)
+    {
+        printf("Usage: %s [units] [ticks] [tick time] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    BenchmarkRandom rand(seed);
+    EventWorld<MultimapEventProcessor> multimapWorld(units);
+    EventWorld<EventProcessor> heapWorld(units);
+    std::vector<EventOp> ops;
+
+    uint64 multimapTime = 0, heapTime = 0, multimapMax = 0, heapMax = 0;
+    uint64 opCount = 0, mismatches = 0;
+    uint32 nextId = 0;
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        ops.clear();
+
+        for (uint32 unit = 0; unit < units; ++unit)
+        {
+            // the generator does not look at the processors, ops without effect are ignored by both
+            if (rand.Next(1000) < CastChance)
+                ops.push_back(EventOp(EVENT_OP_CAST, unit, ++nextId, rand.Next(MaxCastTime)));
+            if (rand.Next(1000) < InterruptChance)
+                ops.push_back(EventOp(EVENT_OP_INTERRUPT, unit, 0, 0));
+            if (rand.Next(1000) < AssistChance)
+                ops.push_back(EventOp(EVENT_OP_DELAYED, unit, ++nextId, 1500));
+            if (rand.Next(1000) < DespawnChance)
+                ops.push_back(EventOp(EVENT_OP_DELAYED, unit, ++nextId, 1000 + rand.Next(30000)));
+            if (rand.Next(1000) < DeathChance)
+                ops.push_back(EventOp(EVENT_OP_DEATH, unit, 0, 0));
+
+            ops.push_back(EventOp(EVENT_OP_UPDATE, unit, 0, 0));
+        }
+
+        uint64 start = GetTime();
+        for (std::vector<EventOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            multimapWorld.Apply(*itr, tickTime);
+        uint64 elapsed = GetTime() - start;
+        multimapTime += elapsed;
+        multimapMax = std::max(multimapMax, elapsed);
+
+        start = GetTime();
+        for (std::vector<EventOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            heapWorld.Apply(*itr, tickTime);
+        elapsed = GetTime() - start;
+        heapTime += elapsed;
+        heapMax = std::max(heapMax, elapsed);
+
+        opCount += ops.size();
+        EventTrace const& multimapTrace = multimapWorld.GetTrace();
+        EventTrace const& heapTrace = heapWorld.GetTrace();
+        if (multimapTrace.Hash != heapTrace.Hash || multimapTrace.Aborts != heapTrace.Aborts)
+            ++mismatches;
+    }
+
+    EventTrace const& trace = heapWorld.GetTrace();
+    printf("units %u, ticks %u, tick time %u ms, seed %u\n", units, ticks, tickTime, seed);
+    printf("operations " UI64FMTD ", events executed " UI64FMTD ", aborted " UI64FMTD "\n", opCount, trace.Executions, trace.Aborts);
+    printf("multimap: average %.2f us per tick, max " UI64FMTD " us\n", ticks ? double(multimapTime) / ticks : 0.0, multimapMax);
+    printf("binary heap: average %.2f us per tick, max " UI64FMTD " us\n", ticks ? double(heapTime) / ticks : 0.0, heapMax);
+    printf("ticks with mismatching events: " UI64FMTD "\n", mismatches);
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Offline benchmark of the dungeon finder queue.
+ *
+ * Keeps a fixed number of solo players queued in one LFGQueue and calls
+ * FindGroups once per tick, like LFGMgr::Update does. Every tick some players
+ * leave and new ones join to refill the queue; matched players accept at once
+ * and are removed. The workload only depends on the seed, so two runs with the
+ * same arguments check the same combinations.
+ *
+ * Usage: lfgqueuebenchmark [queuers] [ticks] [seed]
+ */
+
+#include "Common.h"
+#include "ObjectDefines.h"
+#include "LFGMgr.h"
+#include "LFGQueue.h"
+#include "Timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+
+namespace
+{
+    uint32 const DungeonCount   = 12;                      // dungeons a player can select
+    uint32 const RandomChance   = 30;                      // % of players queueing for every dungeon
+    uint32 const LeaveChance    = 5;                       // per mille of queued players leaving each tick
+
+    // Small LCG, the workload must not depend on the server random generator
+    class BenchmarkRandom
+    {
+        public:
+            explicit BenchmarkRandom(uint32 seed) : _state(seed) { }
+
+            uint32 Next(uint32 max)
+            {
+                _state = _state * 1103515245 + 12345;
+                return ((_state >> 16) & 0x7FFF) % max;
+            }
+
+        private:
+            uint32 _state;
+    };
+
+    uint8 RandomRoles(BenchmarkRandom& rand)
+    {
+        uint32 roll = rand.Next(100);
+        if (roll < 10)
+            return PLAYER_ROLE_TANK;
+        if (roll < 25)
+            return PLAYER_ROLE_HEALER;
+        if (roll < 32)
+            return PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE;
+        if (roll < 40)
+            return PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE;
+        return PLAYER_ROLE_DAMAGE;
+    }
+
+    void RandomDungeons(BenchmarkRandom& rand, LfgDungeonSet& dungeons)
+    {
+        if (rand.Next(100) < RandomChance)
+        {
+            for (uint32 i = 1; i <= DungeonCount; ++i)
+                dungeons.insert(i);
+            return;
+        }
+
+        uint32 count = 1 + rand.Next(3);
+        for (uint32 i = 0; i < count; ++i)
+            dungeons.insert(1 + rand.Next(DungeonCount));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 queuers = argc > 1 ? uint32(atoi(argv[1])) : 2000;
+    uint32 ticks = argc > 2 ? uint32(atoi(argv[2])) : 600;
+    uint32 seed = argc > 3 ? uint32(atoi(argv[3])) : 1;
+
+    BenchmarkRandom rand(seed);
+    LFGQueue queue;
+    std::map<uint64, uint32> queued;                       // guid -> join tick
+    uint32 nextGuid = 1;
+
+    uint64 findTime = 0, findMax = 0, leaveTime = 0;
+    uint32 joins = 0, leaves = 0, matched = 0, proposals = 0;
+    uint64 waitTicks = 0;
+    uint32 maxCompatibles = 0, maxIndex = 0;
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        // Players giving up
+        uint64 start = getUSTime();
+        for (std::map<uint64, uint32>::iterator itr = queued.begin(); itr != queued.end();)
+        {
+            if (rand.Next(1000) >= LeaveChance)
+            {
+                ++itr;
+                continue;
+            }
+
+            queue.RemoveFromQueue(itr->first);
+            sLFGMgr->RemovePlayerData(itr->first);
+            queued.erase(itr++);
+            ++leaves;
+        }
+        leaveTime += getUSTime() - start;
+
+        // Refill the queue
+        while (queued.size() < queuers)
+        {
+            uint64 guid = MAKE_NEW_GUID(nextGuid++, 0, HIGHGUID_PLAYER);
+            LfgDungeonSet dungeons;
+            RandomDungeons(rand, dungeons);
+            LfgRolesMap roles;
+            roles[guid] = RandomRoles(rand);
+
+            sLFGMgr->SetState(guid, LFG_STATE_QUEUED);
+            queue.AddQueueData(guid, time(NULL), dungeons, roles);
+            queued[guid] = tick;
+            ++joins;
+        }
+
+        start = getUSTime();
+        proposals += queue.FindGroups();
+        uint64 elapsed = getUSTime() - start;
+        findTime += elapsed;
+        findMax = std::max(findMax, elapsed);
+
+        // Players not in the queue lists any more got a proposal, they accept
+        LfgGuidList const& current = queue.GetCurrentQueue();
+        std::set<uint64> waiting(current.begin(), current.end());
+        for (std::map<uint64, uint32>::iterator itr = queued.begin(); itr != queued.end();)
+        {
+            if (waiting.find(itr->first) != waiting.end())
+            {
+                ++itr;
+                continue;
+            }
+
+            waitTicks += tick - itr->second;
+            queue.RemoveFromQueue(itr->first);
+            sLFGMgr->RemovePlayerData(itr->first);
+            queued.erase(itr++);
+            ++matched;
+        }
+
+        maxCompatibles = std::max(maxCompatibles, queue.GetCompatibleCount());
+        maxIndex = std::max(maxIndex, queue.GetCompatibleIndexCount());
+    }
+
+    printf("queuers %u, ticks %u, seed %u\n", queuers, ticks, seed);
+    printf("joins %u, leaves %u, matched players %u, proposals %u, average wait %.2f ticks\n",
+        joins, leaves, matched, proposals, matched ? double(waitTicks) / matched : 0.0);
+    printf("FindGroups: average %.1f us, max " UI64FMTD " us\n", ticks ? double(findTime) / ticks : 0.0, findMax);
+    printf("leaves: average %.1f us per player\n", leaves ? double(leaveTime) / leaves : 0.0);
+    printf("compatible cache: %u entries (max %u), guid index: %u keys (max %u)\n",
+        queue.GetCompatibleCount(), maxCompatibles, queue.GetCompatibleIndexCount(), maxIndex);
+    return 0;
+}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Offline benchmark of threat list maintenance under raid threat churn.
+ *
+ * A raid fights a number of creatures. Every tick raid members add threat,
+ * drop threat by a percentage, die and come back, and every creature picks
+ * its victim with the 110%/130% rules of ThreatContainer::selectNextVictim.
+ * The same operations run against two threat lists:
+ * - the old one: a std::list searched linearly by guid and sorted before
+ *   the victim is picked if threat changed;
+ * - the indexed heap ThreatContainer uses now, with a guid map and a
+ *   best-first walk of the heap.
+ * Both must pick the same victims, mismatches are reported. The workload
+ * only depends on the seed.
+ *
+ * Usage: threatbenchmark [creatures] [raid size] [ticks] [seed]
+ */
+
+#include "Define.h"
+#include "Dynamic/UnorderedMap.h"
+#include "Dynamic/IndexedHeap.h"
+
+#include <ace/OS_NS_sys_time.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+namespace
+{
+    uint32 const ThreatChance   = 60;                      // % of living members adding threat to a creature each tick
+    uint32 const DropChance     = 2;                       // per mille of members dropping threat on a creature each tick
+    uint32 const DeathChance    = 2;                       // per mille of living members dying each tick
+    uint32 const RezChance      = 50;                      // per mille of dead members coming back each tick
+
+    uint64 GetTime()
+    {
+        ACE_Time_Value now = ACE_OS::gettimeofday();
+        ACE_UINT64 usec;
+        now.to_usec(usec);
+        return usec;
+    }
+
+    // Small LCG, the workload must not depend on the server random generator
+    class BenchmarkRandom
+    {
+        public:
+            explicit BenchmarkRandom(uint32 seed) : _state(seed) { }
+
+            uint32 Next(uint32 max)
+            {
+                _state = _state * 1103515245 + 12345;
+                return ((_state >> 16) & 0x7FFF) % max;
+            }
+
+        private:
+            uint32 _state;
+    };
+
+    bool IsMelee(uint64 guid) { return guid % 3 != 0; }
+    bool IsTank(uint64 guid) { return guid % 10 == 1; }
+
+    struct ThreatEntry
+    {
+        ThreatEntry(uint64 guid, uint32 sequence) : Guid(guid), Threat(0.0f), Sequence(sequence), HeapIndex(0) { }
+
+        uint64 Guid;
+        float Threat;
+        uint32 Sequence;                                   // orders equal threat, earlier added first
+        size_t HeapIndex;
+    };
+
+    struct ThreatEntryOrder
+    {
+        static bool IsBefore(ThreatEntry const* a, ThreatEntry const* b)
+        {
+            if (a->Threat != b->Threat)
+                return a->Threat > b->Threat;
+
+            return a->Sequence < b->Sequence;
+        }
+
+        static size_t& HeapIndex(ThreatEntry* entry) { return entry->HeapIndex; }
+    };
+
+    enum ThreatOpType
+    {
+        THREAT_OP_ADD,
+        THREAT_OP_PERCENT,
+        THREAT_OP_REMOVE,
+        THREAT_OP_SELECT
+    };
+
+    struct ThreatOp
+    {
+        ThreatOp(ThreatOpType type, uint32 creature, uint64 guid, float value) : Type(type), Creature(creature), Guid(guid), Value(value) { }
+
+        ThreatOpType Type;
+        uint32 Creature;
+        uint64 Guid;
+        float Value;
+    };
+
+    // 110% threat rule for targets in melee range, 130% otherwise; entries are visited in threat order
+    bool IsBetterVictim(ThreatEntry const* entry, ThreatEntry const* current, bool& keepCurrent)
+    {
+        keepCurrent = false;
+        if (!current)
+            return true;
+
+        if (entry == current || entry->Threat <= 1.1f * current->Threat)
+        {
+            keepCurrent = true;
+            return true;
+        }
+
+        return entry->Threat > 1.3f * current->Threat || (entry->Threat > 1.1f * current->Threat && IsMelee(entry->Guid));
+    }
+
+    // Threat list as ThreatContainer kept it before the heap
+    class ListThreat
+    {
+        public:
+            ListThreat() : _dirty(false), _sequence(0), _victim(0) { }
+            ~ListThreat()
+            {
+                for (std::list<ThreatEntry*>::iterator itr = _list.begin(); itr != _list.end(); ++itr)
+                    delete *itr;
+            }
+
+            void Apply(ThreatOp const& op)
+            {
+                std::list<ThreatEntry*>::iterator itr = Find(op.Guid);
+                switch (op.Type)
+                {
+                    case THREAT_OP_ADD:
+                        if (itr == _list.end())
+                            itr = _list.insert(_list.end(), new ThreatEntry(op.Guid, ++_sequence));
+                        (*itr)->Threat += op.Value;
+                        _dirty = true;
+                        break;
+                    case THREAT_OP_PERCENT:
+                        if (itr != _list.end())
+                        {
+                            (*itr)->Threat += (*itr)->Threat * op.Value / 100.0f;
+                            _dirty = true;
+                        }
+                        break;
+                    case THREAT_OP_REMOVE:
+                        if (itr != _list.end())
+                        {
+                            delete *itr;
+                            _list.erase(itr);
+                        }
+                        break;
+                    case THREAT_OP_SELECT:
+                        Select();
+                        break;
+                }
+            }
+
+            uint64 GetVictim() const { return _victim; }
+
+        private:
+            std::list<ThreatEntry*>::iterator Find(uint64 guid)
+            {
+                std::list<ThreatEntry*>::iterator itr = _list.begin();
+                for (; itr != _list.end(); ++itr)
+                    if ((*itr)->Guid == guid)
+                        break;
+                return itr;
+            }
+
+            void Select()
+            {
+                if (_dirty && _list.size() > 1)
+                    _list.sort(&ThreatEntryOrder::IsBefore);
+                _dirty = false;
+
+                std::list<ThreatEntry*>::iterator current = Find(_victim);
+                ThreatEntry const* currentEntry = current != _list.end() ? *current : NULL;
+
+                _victim = 0;
+                for (std::list<ThreatEntry*>::const_iterator itr = _list.begin(); itr != _list.end(); ++itr)
+                {
+                    bool keepCurrent;
+                    if (IsBetterVictim(*itr, currentEntry, keepCurrent))
+                    {
+                        _victim = keepCurrent ? currentEntry->Guid : (*itr)->Guid;
+                        break;
+                    }
+                }
+            }
+
+            std::list<ThreatEntry*> _list;
+            bool _dirty;
+            uint32 _sequence;
+            uint64 _victim;
+    };
+
+    // Threat list as ThreatContainer keeps it now
+    class HeapThreat
+    {
+        public:
+            typedef UNORDERED_MAP<uint64, ThreatEntry*> EntryMap;
+
+            HeapThreat() : _sequence(0), _victim(0) { }
+            ~HeapThreat()
+            {
+                for (EntryMap::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+                    delete itr->second;
+            }
+
+            void Apply(ThreatOp const& op)
+            {
+                EntryMap::iterator itr = _entries.find(op.Guid);
+                switch (op.Type)
+                {
+                    case THREAT_OP_ADD:
+                        if (itr == _entries.end())
+                        {
+                            ThreatEntry* entry = new ThreatEntry(op.Guid, ++_sequence);
+                            itr = _entries.insert(EntryMap::value_type(op.Guid, entry)).first;
+                            _heap.push(entry);
+                        }
+                        itr->second->Threat += op.Value;
+                        _heap.update(itr->second);
+                        break;
+                    case THREAT_OP_PERCENT:
+                        if (itr != _entries.end())
+                        {
+                            itr->second->Threat += itr->second->Threat * op.Value / 100.0f;
+                            _heap.update(itr->second);
+                        }
+                        break;
+                    case THREAT_OP_REMOVE:
+                        if (itr != _entries.end())
+                        {
+                            _heap.erase(itr->second);
+                            delete itr->second;
+                            _entries.erase(itr);
+                        }
+                        break;
+                    case THREAT_OP_SELECT:
+                        Select();
+                        break;
+                }
+            }
+
+            uint64 GetVictim() const { return _victim; }
+
+        private:
+            void Select()
+            {
+                EntryMap::const_iterator current = _entries.find(_victim);
+                ThreatEntry const* currentEntry = current != _entries.end() ? current->second : NULL;
+
+                _victim = 0;
+                _walker.start(_heap);
+                while (!_walker.done())
+                {
+                    ThreatEntry const* entry = _walker.next();
+                    bool keepCurrent;
+                    if (IsBetterVictim(entry, currentEntry, keepCurrent))
+                    {
+                        _victim = keepCurrent ? currentEntry->Guid : entry->Guid;
+                        break;
+                    }
+                }
+            }
+
+            EntryMap _entries;
+            Trinity::IndexedHeap<ThreatEntry, ThreatEntryOrder> _heap;
+            Trinity::IndexedHeapWalker<ThreatEntry, ThreatEntryOrder> _walker;
+            uint32 _sequence;
+            uint64 _victim;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    uint32 creatures = argc > 1 ? uint32(atoi(argv[1])) : 10;
+    uint32 raidSize = argc > 2 ? uint32(atoi(argv[2])) : 40;
+    uint32 ticks = argc > 3 ? uint32(atoi(argv[3])) : 10000;
+    uint32 seed = argc > 4 ? uint32(atoi(argv[4])) : 1;
+
+    if (!creatures || !raidSize)
+    {
+        printf("Usage: %s [creatures] [raid size] [ticks] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    BenchmarkRandom rand(seed);
+    std::vector<ListThreat> listThreat(creatures);
+    std::vector<HeapThreat> heapThreat(creatures);
+    std::vector<bool> alive(raidSize, true);
+    std::vector<ThreatOp> ops;
+
+    uint64 listTime = 0, heapTime = 0, listMax = 0, heapMax = 0;
+    uint64 opCount = 0, selections = 0, mismatches = 0, victimChanges = 0;
+    std::vector<uint64> lastVictim(creatures, 0);
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        ops.clear();
+
+        for (uint32 member = 0; member < raidSize; ++member)
+        {
+            uint64 guid = member + 1;
+            if (!alive[member])
+            {
+                if (rand.Next(1000) < RezChance)
+                    alive[member] = true;
+                continue;
+            }
+
+            if (rand.Next(1000) < DeathChance)
+            {
+                alive[member] = false;
+                for (uint32 creature = 0; creature < creatures; ++creature)
+                    ops.push_back(ThreatOp(THREAT_OP_REMOVE, creature, guid, 0.0f));
+                continue;
+            }
+
+            for (uint32 creature = 0; creature < creatures; ++creature)
+            {
+                if (rand.Next(100) < ThreatChance)
+                {
+                    float threat = float(100 + rand.Next(2900));
+                    if (IsTank(guid))
+                        threat *= 5.0f;
+                    ops.push_back(ThreatOp(THREAT_OP_ADD, creature, guid, threat));
+                }
+
+                if (rand.Next(1000) < DropChance)
+                    ops.push_back(ThreatOp(THREAT_OP_PERCENT, creature, guid, rand.Next(2) ? -50.0f : -100.0f));
+            }
+        }
+
+        for (uint32 creature = 0; creature < creatures; ++creature)
+            ops.push_back(ThreatOp(THREAT_OP_SELECT, creature, 0, 0.0f));
+
+        uint64 start = GetTime();
+        for (std::vector<ThreatOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            listThreat[itr->Creature].Apply(*itr);
+        uint64 elapsed = GetTime() - start;
+        listTime += elapsed;
+        listMax = std::max(listMax, elapsed);
+
+        start = GetTime();
+        for (std::vector<ThreatOp>::const_iterator itr = ops.begin(); itr != ops.end(); ++itr)
+            heapThreat[itr->Creature].Apply(*itr);
+        elapsed = GetTime() - start;
+        heapTime += elapsed;
+        heapMax = std::max(heapMax, elapsed);
+
+        opCount += ops.size();
+        for (uint32 creature = 0; creature < creatures; ++creature)
+        {
+            ++selections;
+            uint64 victim = heapThreat[creature].GetVictim();
+            if (victim != listThreat[creature].GetVictim())
+                ++mismatches;
+            if (victim != lastVictim[creature])
+                ++victimChanges;
+            lastVictim[creature] = victim;
+        }
+    }
+
+    printf("creatures %u, raid size %u, ticks %u, seed %u\n", creatures, raidSize, ticks, seed);
+    printf("operations " UI64FMTD ", victim selections " UI64FMTD ", victim changes " UI64FMTD "\n", opCount, selections, victimChanges);
+    printf("list + sort: average %.2f us per tick, max " UI64FMTD " us\n", ticks ? double(listTime) / ticks : 0.0, listMax);
+    printf("indexed heap: average %.2f us per tick, max " UI64FMTD " us\n", ticks ? double(heapTime) / ticks : 0.0, heapMax);
+    printf("victim mismatches: " UI64FMTD "\n", mismatches);
+    return mismatches ? 2 : 0;
+}